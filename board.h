@@ -12,6 +12,10 @@
 // 2004 LCD PCF8574 I2C address
 constexpr int LCD_ADDR = 0x27;
 
+// 2004 LCD geometry
+constexpr int LCD_COLS = 20;
+constexpr int LCD_ROWS = 4;
+
 // I2C IO pins
 constexpr int I2C_SDA = 4;
 constexpr int I2C_SCL = 5;
@@ -9,9 +9,19 @@
 
 #include <cstdint>
 #include "board.h"
-#include "src/display/display.hpp"
+#include "src/display/backend.hpp"  // RgbColor
 
-constexpr bool DEBUG_ENABLE = false;  // verbose serial debug info
+constexpr bool DEBUG_ENABLE = false;   // verbose serial debug info
+constexpr bool LCD_BENCHMARK = false;  // measure LCD throughput on boot
+constexpr bool POWER_SAVE = true;      // sleep the CPU and radio between frames
+constexpr bool FAST_BOOT = true;       // rejoin the last AP without scan, restore the time after reset
+constexpr bool FAST_BOOT_IP = false;   // reuse the last IP without DHCP, reserve it in the router first!
+
+// Games to build in, disable the unused ones to save flash and RAM
+constexpr bool ETS2_ENABLE = true;       // with ETS2 Telemetry Web Server
+constexpr bool ETS2_PUSH_ENABLE = true;  // with tools/ets2_bridge
+constexpr bool FORZA_ENABLE = true;
+constexpr bool DIRT_ENABLE = true;  // and the other Codemasters games
 
 // Wi-Fi and API server
 constexpr const char *SSID = "YOUR WIFI SSID";
@@ -29,6 +39,13 @@ constexpr bool SHOW_MILE = false;   // display with mile instead of km
 constexpr bool CLOCK_BLINK = true;  // blink the ":" mark in ETS2 dashboard clock
 constexpr bool CLOCK_12H = true;    // display ETS2 dashboard clock in 12 hour
 
+// Mode switch hysteresis (ms), against bouncing between the dashboard and the
+// clock on menu flickers or lossy links, as each switch redraws the screen
+constexpr int MODE_PAUSE_HOLD = 1500;   // paused in game, before showing the clock
+constexpr int MODE_GONE_GRACE = 5000;   // no data, the dashboard is marked stale until the game is gone
+constexpr int MODE_DASH_DWELL = 3000;   // minimum time on the dashboard
+constexpr int MODE_CLOCK_DWELL = 1000;  // minimum time on the clock
+
 // Backlight levels
 constexpr int BACKLIGHT_MAX = 255;
 constexpr int BACKLIGHT_OFF = 0;
@@ -85,6 +102,10 @@ constexpr const char *EV_TRUCKS[]{
 // ETS2: fallback fuel capacity on data error (Iveco S-Way, etc.)
 constexpr double DEFAULT_TANK_SIZE = 1200;
 
+// ETS2: adaptive telemetry polling interval bounds (ms), 500 when cruising
+constexpr int ETS2_POLL_FAST = 100;   // speed or lights changing
+constexpr int ETS2_POLL_SLOW = 2000;  // parked or paused
+
 // Truck: LED indicators map
 enum LedSlot {
   LBLINKER,
@@ -118,6 +139,14 @@ constexpr int FORZA_PRO_CLASS = 4;
 // Set to false to use normal dashboard.
 constexpr bool DIRT_PRO_STYLE = true;
 
+// Racing: telemetry polling interval in menus (ms), the frame rate in race
+constexpr int RACING_POLL_SLOW = 200;
+
+// Flush budget of a frame in LCD bytes (~90us each at 400kHz), 0 for unlimited.
+// Over the budget, the less important fields are delayed to the next frames.
+constexpr int RACING_FLUSH_BUDGET = 60;  // of the 33ms frame
+constexpr int TRUCK_FLUSH_BUDGET = 0;
+
 // Racing: shift zone
 constexpr float RACING_SHIFT_ZONE = 85.0;
 constexpr float RACING_RED_ZONE = 90.0;
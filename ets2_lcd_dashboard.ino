@@ -14,74 +14,79 @@
 #include "board.h"
 #include "config.h"
 #include "src/clock/ntp_clock.hpp"
+#include "src/display/esp_backend.hpp"
+#include "src/game/controller.hpp"
 #include "src/game/dirt.hpp"
 #include "src/game/ets2.hpp"
+#include "src/game/ets2_push.hpp"
 #include "src/game/forza.hpp"
 #include "src/game/game.hpp"
+#include "src/net/boot_cache.hpp"
+#include "src/net/wifi_link.hpp"
+#include "src/sched/idle.hpp"
+#include "src/sched/task.hpp"
 #include "src/utils.hpp"
 
 static constexpr int NTP_UPDATE = 60 * 60 * 1000;  // interval to sync clock with NTP
 
-static Display disp(I2C_SDA, I2C_SCL, I2C_FREQ, LCD_LED_PWM, RGB_LED_PIN, LCD_ADDR);
+static EspBackend backend(I2C_SDA, I2C_SCL, I2C_FREQ, LCD_LED_PWM, RGB_LED_PIN, RGB_LED_NUM);
+static Display disp(backend, LCD_ADDR);
 
 static ClockDashboard clockDash(disp);
 static NtpClock ntpClock(clockDash, NTP_SERVER, (TIME_ZONE - DST * 60) * 60, NTP_UPDATE);
 
-static TruckDashboard truckDash(disp);
-static Ets2Game ets2(truckDash, ETS_API);
+static DashSlot<TruckDashboard, ETS2_ENABLE || ETS2_PUSH_ENABLE> truckDash(disp);
+static GameSlot<Ets2Game, ETS2_ENABLE> ets2(truckDash, ETS_API);
+static GameSlot<Ets2PushGame, ETS2_PUSH_ENABLE> ets2Push(truckDash, ETS2_PUSH_PORT);
 
-static RacingDashboard racingDash(disp);
-static ForzaGame forza(racingDash, FORZA_PORT);
-static DirtGame dirt(racingDash, DIRT_PORT);
+static DashSlot<RacingDashboard, FORZA_ENABLE || DIRT_ENABLE> racingDash(disp);
+static GameSlot<ForzaGame, FORZA_ENABLE> forza(racingDash, FORZA_PORT);
+static GameSlot<DirtGame, DIRT_ENABLE> dirt(racingDash, DIRT_PORT);
 
-static Game *games[] = { &ets2, &forza, &dirt };
-static Controller controller(ntpClock, games, ARRAY_SIZE(games));
+// the pushed telemetry is preferred if the bridge is running
+static Controller controller(disp, ntpClock, ets2Push, ets2, forza, dirt);
+static TaskRunner tasks(millis, micros);
+static IdleManager idle(tasks);
 
 static void serviceStart() {
   ntpClock.start();
   controller.startGames();
+  disp.overlayHide(Display::Layer::SYSTEM);
 }
 
 static void serviceStop() {
   ntpClock.stop();
   controller.stopGames();
+  disp.overlay(Display::Layer::SYSTEM, 11, 3, "WiFi lost");  // until reconnected
 }
 
-static void wifiConnect(std::function<void()> tick) {
-  Serial.printf("Connecting to %s .", SSID);
-
-  WiFi.mode(WIFI_STA);
-  WiFi.begin(SSID, PASSWORD);
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
-    tick();
-  }
-
-  Serial.printf(" Local IP: %s\n", WiFi.localIP().toString().c_str());
-  serviceStart();
-}
+static WifiLink wifi(SSID, PASSWORD, serviceStart, serviceStop);
 
 void setup() {
   Serial.begin(SERIAL_BAUDRATE);
   disp.start();
-  wifiConnect([] {});
+  tasks.add(disp.bus());
+  controller.addTasks(tasks);  // receive and parse apart from the frames
 
-  if (CLOCK_ENABLE) {
-    ntpClock.initialSync();
-    ntpClock.freshDisplay();
+  // show the clock at once after a reset, before the NTP sync
+  if (FAST_BOOT) {
+    ntpClock.restore(BootCache::loadEpoch());
   }
+
+  // connect and sync in background, show the clock once the time is known
+  tasks.add(wifi);
+  tasks.add(ntpClock);
 }
 
 void loop() {
-  if (WiFi.status() != WL_CONNECTED) {
-    Serial.println("WiFi disconnected.");
-    serviceStop();
-    wifiConnect([] {
-      ntpClock.tick();
-    });
-  }
-
+  tasks.tick();
   controller.tick();
   ntpClock.tick();
+
+  if (POWER_SAVE) {
+    idle.radioSleep(!controller.driving());  // no extra latency in game
+    unsigned long next = controller.nextDeadline(idle.horizon());
+    next = tasks.nextDeadline(next);
+    idle.sleepUntil(ntpClock.nextDeadline(next));
+  }
 }
@@ -9,41 +9,126 @@
 #include <TimeLib.h>
 #include "../../config.h"
 #include "../utils.hpp"
+#include "../net/boot_cache.hpp"
+#include "../sched/idle.hpp"
 
-#ifdef ESP8266
-#include <ESP8266WiFi.h>
-#else
-#include <WiFi.h>
-#endif
+static constexpr uint16_t NTP_PORT = 123;
+static constexpr uint16_t LOCAL_PORT = 2390;
+static constexpr unsigned long SEVENTY_YEARS = 2208988800UL;  // NTP epoch is 1900
 
-NtpClock::NtpClock(ClockDashboard &dash, const char* server, long timeOffset, unsigned long updateInterval)
-  : dash_(dash), ntp_(NTPClient(udp_, server, timeOffset, updateInterval)) {}
+static inline uint32_t readBE32(const uint8_t *p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+void NtpClock::start() {
+  udp_.begin(LOCAL_PORT);
+  online_ = true;
+}
+
+void NtpClock::stop() {
+  online_ = false;
+  udp_.stop();
+}
 
-void NtpClock::initialSync() {
-  Serial.printf("NTP syncing with %s .", server_.c_str());
-  while (!ntp_.forceUpdate()) {
-    delay(500);
-    Serial.print(".");
+void NtpClock::restore(unsigned long bootEpoch) {
+  if (bootEpoch != 0 && !synced_) {
+    epoch_ = bootEpoch;
+    syncMs_ = 0;
   }
-  Serial.printf(" Local Time: %s\n", ntp_.getFormattedTime().c_str());
 }
 
-void NtpClock::tick() {
-  if (!CLOCK_ENABLE || !inDisplay()) {
-    return;  // avoid sync in game to prevent unexpected latency
+unsigned long NtpClock::time() const {
+  if (epoch_ == 0) {
+    return 0;
+  }
+  return epoch_ + (millis() - syncMs_) / 1000;
+}
+
+bool NtpClock::sendRequest() {
+  uint8_t pkt[PACKET_SIZE]{};
+  pkt[0] = 0xE3;  // LI unknown, version 4, client mode
+  pkt[2] = 6;     // poll interval
+  pkt[3] = 0xEC;  // precision
+
+  while (udp_.parsePacket() > 0) {
+    udp_.flush();  // late response of the last request
+  }
+  sentAt_ = millis();
+  return udp_.beginPacket(server_, NTP_PORT) && udp_.write(pkt, sizeof(pkt)) == sizeof(pkt) && udp_.endPacket();
+}
+
+bool NtpClock::readResponse() {
+  uint8_t pkt[PACKET_SIZE];
+  if (udp_.read(pkt, sizeof(pkt)) != static_cast<int>(sizeof(pkt))) {
+    return false;
+  }
+  // server mode only, stratum 0 is the kiss-of-death
+  if ((pkt[0] & 0x07) != 4 || pkt[1] == 0) {
+    return false;
   }
 
-  if (ntp_.getEpochTime() == lastUpdate_) {
+  // transmit timestamp, taken at the middle of the round trip
+  unsigned long now = millis();
+  unsigned long fraction = (static_cast<uint64_t>(readBE32(pkt + 44)) * 1000) >> 32;
+  epoch_ = readBE32(pkt + 40) - SEVENTY_YEARS + timeOffset_;
+  syncMs_ = now - (now - sentAt_) / 2 - fraction;
+  synced_ = true;
+  return true;
+}
+
+void NtpClock::run() {
+  TASK_BEGIN();
+  while (CLOCK_ENABLE) {
+    // avoid sync in game to prevent unexpected latency, unless never synced
+    TASK_AWAIT_POLL(online_ && (!synced() || inDisplay()), IDLE_POLL);
+
+    if (!sendRequest()) {
+      DEBUG("NTP request to %s failed.\n", server_);
+      TASK_SLEEP(NTP_RETRY);
+      continue;
+    }
+
+    TASK_AWAIT_FOR(!online_ || udp_.parsePacket() > 0, NTP_TIMEOUT);
+    if (timedOut() || !online_ || !readResponse()) {
+      DEBUG("NTP sync with %s failed.\n", server_);
+      TASK_SLEEP(NTP_RETRY);
+      continue;
+    }
+
+    Serial.printf("NTP sync success: %02d:%02d:%02d.\n", hour(time()), minute(time()), second(time()));
+    TASK_SLEEP(updateInterval_);
+  }
+  TASK_END();
+}
+
+void NtpClock::tick() {
+  unsigned long t = time();
+  if (t == lastUpdate_) {
     return;
   }
+  lastUpdate_ = t;
+  secondAt_ = (t != 0) ? millis() - (millis() - syncMs_) % 1000 : millis();
 
-  if (WiFi.status() == WL_CONNECTED && ntp_.update()) {
-    Serial.printf("NTP sync success: %s.\n", ntp_.getFormattedTime().c_str());
+  if (FAST_BOOT && t != 0) {
+    BootCache::saveEpoch(t);
   }
+  if (CLOCK_ENABLE && inDisplay()) {
+    freshDisplay();
+  }
+}
 
-  freshDisplay();
+unsigned long NtpClock::nextDeadline(unsigned long next) {
+  if (!CLOCK_ENABLE || !inDisplay()) {
+    return next;
+  }
+  return earliest(next, secondAt_ + 1000);
 }
 
 void NtpClock::freshDisplay() {
-  dash_.fresh(this, CLOCK_ENABLE ? ntp_.getEpochTime() : 0);
+  unsigned long t = CLOCK_ENABLE ? time() : 0;
+  if (t != 0 && !shown_) {
+    shown_ = true;
+    Serial.printf("First clock frame in %lums%s\n", millis(), synced() ? "" : " (estimated time)");
+  }
+  dash_.fresh(this, t);
 }
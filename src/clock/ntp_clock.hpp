@@ -8,39 +8,67 @@
 #pragma once
 
 #include <Arduino.h>
-#include <NTPClient.h>
 #include <WiFiUdp.h>
 #include "../dashboard/clock.hpp"
+#include "../sched/task.hpp"
 
-class NtpClock {
+// SNTP client as a task, which never blocks the loop while waiting for the
+// server. The clock counts from the last sync with millis() in between.
+class NtpClock : public Task {
 public:
-  NtpClock(ClockDashboard &dash, const char *server, long timeOffset, unsigned long updateInterval);
+  NtpClock(ClockDashboard &dash, const char *server, long timeOffset, unsigned long updateInterval)
+    : Task("ntp"), dash_(dash), server_(server), timeOffset_(timeOffset), updateInterval_(updateInterval) {}
 
-  inline void start() {
-    ntp_.begin();
-  }
+  void start();
+  void stop();
 
-  inline void stop() {
-    ntp_.end();
-  }
+  // count from the time estimated at boot, until the first sync
+  void restore(unsigned long bootEpoch);
+
+  // local epoch time, 0 for unknown
+  unsigned long time() const;
 
-  inline unsigned long time() {
-    return ntp_.getEpochTime();
+  // synced with NTP since boot
+  inline bool synced() const {
+    return synced_;
   }
 
   inline bool inDisplay() {
     return dash_.getDisplay().isOwnedBy(this);
   }
 
-  void initialSync();
   void tick();
   void freshDisplay();
 
+  // the earlier one of next and the next second to display
+  unsigned long nextDeadline(unsigned long next);
+
+protected:
+  void run() override;
+
 private:
+  bool sendRequest();
+  bool readResponse();
+
+private:
+  static constexpr size_t PACKET_SIZE = 48;
+  static constexpr unsigned long NTP_TIMEOUT = 1000;  // ms
+  static constexpr unsigned long NTP_RETRY = 2000;    // ms
+  static constexpr unsigned long IDLE_POLL = 100;     // ms, wait for the clock mode
+
   ClockDashboard &dash_;
-  String server_;
-  NTPClient ntp_;
+  const char *server_;
+  long timeOffset_;
+  unsigned long updateInterval_;
   WiFiUDP udp_{};
+  bool online_{};
+
+  unsigned long epoch_{};   // local time of the last sync
+  unsigned long syncMs_{};  // millis() at epoch_
+  unsigned long sentAt_{};  // millis() of the request
+  bool synced_{};
+  bool shown_{};  // the first clock frame
 
-  time_t lastUpdate_{ -1 };
+  unsigned long lastUpdate_{ ~0UL };
+  unsigned long secondAt_{};  // millis() when the second changed
 };
@@ -54,12 +54,18 @@ void ClockDashboard::noClock() {
 }
 
 void ClockDashboard::fresh(void *owner, time_t time) {
-  // owner change needs a full update
-  force_ = disp_.setOwner(owner);
+  // owner change needs a full update, unless the last screen is restored
+  force_ = disp_.setOwner(owner, this);
 
-  if (!CLOCK_ENABLE) {
-    // time is not available
+  // redraw all once the time becomes available
+  bool hasTime = CLOCK_ENABLE && time != 0;
+  force_ |= (hasTime != hasTime_);
+  hasTime_ = hasTime;
+
+  if (!hasTime) {
+    // time is not available (yet)
     noClock();
+    disp_.flush();
     disp_.backlightUpdate(force_, BACKLIGHT_CLOCK);
     return;
   }
@@ -69,4 +75,5 @@ void ClockDashboard::fresh(void *owner, time_t time) {
 
   clockInit();
   updateDateTime(time);
+  disp_.flush();
 }
@@ -21,4 +21,7 @@ private:
   void clockInit();
   void updateDateTime(time_t time);
   void noClock();
+
+private:
+  bool hasTime_{};
 };
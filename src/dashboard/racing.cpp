@@ -28,28 +28,29 @@
 void RacingDashboard::printN(int x, int y) {
   // use the strokes defined in LargeDigit
   disp_.setCursor(x, y);
-  disp_.write(1);
-  disp_.write(7);
-  disp_.write(0);
+  disp_.write(disp_.largeStroke(1));
+  disp_.write(disp_.largeStroke(7));
+  disp_.write(disp_.largeStroke(0));
   disp_.setCursor(x, y + 1);
-  disp_.write(1);
+  disp_.write(disp_.largeStroke(1));
   disp_.write(' ');
-  disp_.write(0);
+  disp_.write(disp_.largeStroke(0));
 }
 
 void RacingDashboard::printR(int x, int y) {
   // use the strokes defined in LargeDigit
   disp_.setCursor(x, y);
-  disp_.write(1);
-  disp_.write(7);
-  disp_.write(0);
+  disp_.write(disp_.largeStroke(1));
+  disp_.write(disp_.largeStroke(7));
+  disp_.write(disp_.largeStroke(0));
   disp_.setCursor(x, y + 1);
-  disp_.write(1);
+  disp_.write(disp_.largeStroke(1));
   disp_.write(' ');
   disp_.write(' ');
 }
 
 void RacingDashboard::updateSpeedGear(const RacingState *state) {
+  disp_.setPriority(Display::Priority::NORMAL, TIMER_STALE);
   auto speed = min(state->speed, 999);
   LAZY_UPDATE(speed, {
     if (isPro_) {
@@ -60,6 +61,7 @@ void RacingDashboard::updateSpeedGear(const RacingState *state) {
     DEBUG("Update speed: %d\n", speed);
   });
 
+  disp_.setPriority(Display::Priority::CRITICAL);
   auto gear = min(state->gear, 9);
   LAZY_UPDATE(gear, {
     int x = isPro_ ? 10 : 17;
@@ -76,6 +78,7 @@ void RacingDashboard::updateSpeedGear(const RacingState *state) {
 }
 
 void RacingDashboard::updateLapTime(const RacingState *state) {
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   LAZY_UPDATE(state->bestLap, {
     auto bestTime = min(static_cast<int>(round(state->bestLap / 10.0)), 599999);  // use the stop watch format
     int y = isPro_ ? 3 : 1;
@@ -104,7 +107,22 @@ void RacingDashboard::updateLapTime(const RacingState *state) {
   });
 }
 
+// Pop the delta of a completed lap to the best one before it, over the current
+// lap time which just restarted, without repainting the dashboard.
+void RacingDashboard::updateLapDelta(const RacingState *state) {
+  if (!force_ && state->lastLap != lastLap_ && state->lastLap > 0 && bestLap_ > 0) {
+    float delta = constrain((state->lastLap - bestLap_) / 1000.0f, -99.99f, 99.99f);
+    char text[16];
+    snprintf(text, sizeof(text), "Lap%+6.2f", delta);
+    disp_.overlay(Display::Layer::GAME, isPro_ ? 0 : 11, 1, text, LAP_DELTA_SHOW);
+    DEBUG("Lap delta: %s\n", text);
+  }
+  lastLap_ = state->lastLap;
+  bestLap_ = state->bestLap;
+}
+
 void RacingDashboard::updateCurrTime(const RacingState *state) {
+  disp_.setPriority(Display::Priority::NORMAL, TIMER_STALE);
   if (isPro_) {
     auto currTime = min(static_cast<int>(round(state->currLap / 10.0)), 599999);  // use the stop watch format
     LAZY_UPDATE(currTime, {
@@ -127,6 +145,7 @@ void RacingDashboard::updateCurrTime(const RacingState *state) {
 }
 
 void RacingDashboard::updateLapPos(const RacingState *state) {
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   auto lap = min(state->lap, 99);
   LAZY_UPDATE(lap, {
     int x = isPro_ ? 18 : 14;
@@ -154,14 +173,11 @@ void RacingDashboard::updateFuel(const RacingState *state) {
     return;
   }
 
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   auto fuel = min(state->fuel, 100);
-  int seg = round(fuel / (100.0 / 4));
-  LAZY_UPDATE(seg, {
-    char bar[] = "\xA5\xA5\xA5\xA5";
-    for (int i = 0; i < seg; i++) {
-      bar[i] = 0xFF;
-    }
-    dispPrint(15, 3, bar);
+  int cols = round(fuel / (100.0 / (4 * BarGraph::CELL_COLS)));
+  LAZY_UPDATE(cols, {
+    disp_.printBar(15, 3, 4, cols, 0xA5);
     DEBUG("Update fuel: %d%%\n", fuel);
   });
 }
@@ -195,20 +211,25 @@ void RacingDashboard::ledRedZone() {
 }
 
 void RacingDashboard::updateRpm(const RacingState *state) {
-  auto rpm = state->rpm, rpmIdle = state->rpmIdle, rpmMax = state->rpmMax;
+  disp_.setPriority(Display::Priority::CRITICAL);
+  auto rpm = state->rpm, rpmPeak = state->rpmPeak, rpmIdle = state->rpmIdle, rpmMax = state->rpmMax;
 
   if (rpmMax == 0) {
     // no valid rpm data, just set to 0
     rpm = 0;
+    rpmPeak = 0;
     rpmIdle = 0;
     rpmMax = 10000;
   }
 
-  // calculate engine load
-  rpm = (rpm < rpmIdle) ? rpmIdle : rpm;
-  float load = (rpm - rpmIdle) * 100.0 / (rpmMax - rpmIdle);
+  // calculate engine load, the shift lights never miss a peak between frames
+  auto engineLoad = [&](int r) {
+    r = (r < rpmIdle) ? rpmIdle : r;
+    return static_cast<float>((r - rpmIdle) * 100.0 / (rpmMax - rpmIdle));
+  };
+  float load = engineLoad(rpm), peak = engineLoad(max(rpmPeak, rpm));
 
-  if ((load >= RACING_RED_ZONE) || (inRed_ && (load >= RACING_SHIFT_ZONE))) {
+  if ((peak >= RACING_RED_ZONE) || (inRed_ && (peak >= RACING_SHIFT_ZONE))) {
     // in red zone, just blink the bar
     force_ |= !inRed_;
     inRed_ = true;
@@ -223,31 +244,23 @@ void RacingDashboard::updateRpm(const RacingState *state) {
 
   force_ |= inRed_;
   inRed_ = false;
-  ledProgress(load);
+  ledProgress(peak);
 
   int pct = min(static_cast<int>(round(load * 100.0 / RACING_SHIFT_ZONE)), 100);
   if (isPro_) {
-    // Converging rpm bar [## -> .. <- ##]
-    int seg = round(pct / 10.0);
-    LAZY_UPDATE(seg, {
-      char bar[] = "                    ";
-      for (int i = 0; i < seg; i++) {
-        bar[i] = 0xFF;
-        bar[20 - 1 - i] = 0xFF;
-      }
-      dispPrint(0, 0, bar);
+    // Converging rpm bar [## -> .. <- ##], in pixel columns
+    int cols = round(pct * (LCD_COLS / 2 * BarGraph::CELL_COLS) / 100.0);
+    LAZY_UPDATE(cols, {
+      disp_.printBar(0, 0, LCD_COLS / 2, cols, ' ');
+      disp_.printBar(LCD_COLS / 2, 0, LCD_COLS / 2, cols, ' ', true);
       DEBUG("Update rpm: %.2f%%\n", load);
     });
 
   } else {
-    // Linear rpm bar: [###### ->   ..]
-    int seg = round(pct / (100.0 / 20));
-    LAZY_UPDATE(seg, {
-      char bar[] = "                    ";
-      for (int i = 0; i < seg; i++) {
-        bar[i] = 0xFF;
-      }
-      dispPrint(0, 0, bar);
+    // Linear rpm bar: [###### ->   ..], in pixel columns
+    int cols = round(pct * (LCD_COLS * BarGraph::CELL_COLS) / 100.0);
+    LAZY_UPDATE(cols, {
+      disp_.printBar(0, 0, LCD_COLS, cols, ' ');
       DEBUG("Update rpm: %.2f%%\n", load);
     });
   }
@@ -264,14 +277,19 @@ void RacingDashboard::dashboardInit() {
   dispPrint(0, 3, isPro_ ? "B             E    F" : "          LAP:      ");
 }
 
-void RacingDashboard::fresh(void *owner, const RacingState *state) {
-  // owner/style change needs a full update
-  force_ = disp_.setOwner(owner) || (isPro_ != state->isPro);
+// the free cell between the speed and the lap data of both styles
+void RacingDashboard::updateStale(bool stale) {
+  disp_.setPriority(Display::Priority::NORMAL, TIMER_STALE);
+  LAZY_UPDATE(stale, dispPrint(9, 2, stale ? "!" : " "));
+}
+
+void RacingDashboard::fresh(void *owner, const RacingState *state, bool stale) {
+  // owner/style change needs a full update, unless the last screen is restored
+  force_ = disp_.setOwner(owner, this) || (isPro_ != state->isPro);
   isPro_ = state->isPro;
 
-  constexpr int PERIOD = 2;
-  blinkShow_ = (frameCnt_++ < PERIOD);
-  frameCnt_ %= (PERIOD * 2);
+  constexpr unsigned long PERIOD = 2 * 1000 / FPS;  // ms, 2 frames on and 2 off
+  blinkShow_ = (millis() / PERIOD) % 2 == 0;
 
   disp_.backlightUpdate(force_, BACKLIGHT_DAY);
   disp_.ledBrightnesslUpdate(force_, RGB_LEVEL_DAY);
@@ -281,6 +299,9 @@ void RacingDashboard::fresh(void *owner, const RacingState *state) {
   updateSpeedGear(state);
   updateCurrTime(state);
   updateLapTime(state);
+  updateLapDelta(state);
   updateLapPos(state);
   updateFuel(state);
+  updateStale(stale);
+  disp_.flush(RACING_FLUSH_BUDGET);
 }
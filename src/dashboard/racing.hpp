@@ -14,7 +14,8 @@ struct RacingState {
   int speed;
   int gear;
   int rpmIdle;
-  int rpm;
+  int rpm;      // the latest sample, for the rpm bar
+  int rpmPeak;  // of the samples since the last frame, for the shift lights
   int rpmMax;
   int fuel;    // percentage
   bool isPro;  // high performance car
@@ -32,19 +33,28 @@ public:
   RacingDashboard(Display &display)
     : Dashboard(display){};
 
-  void fresh(void *owner, const RacingState *state);
+  void fresh(void *owner, const RacingState *state, bool stale);
 
 public:
   static constexpr int FPS = 30;  // must be called @ 30FPS
 
+private:
+  // frames the fields may be delayed by the flush budget
+  static constexpr uint16_t TIMER_STALE = FPS / 10;  // speed, current lap
+  static constexpr uint16_t INFO_STALE = FPS / 2;    // best/last lap, POS, LAP, fuel
+
+  static constexpr unsigned long LAP_DELTA_SHOW = 3000;  // ms, over the current lap time
+
 private:
   void dashboardInit();
   void updateSpeedGear(const RacingState *state);
   void updateLapTime(const RacingState *state);
+  void updateLapDelta(const RacingState *state);
   void updateCurrTime(const RacingState *state);
   void updateLapPos(const RacingState *state);
   void updateFuel(const RacingState *state);
   void updateRpm(const RacingState *state);
+  void updateStale(bool stale);
 
   void printN(int x, int y);
   void printR(int x, int y);
@@ -52,7 +62,8 @@ private:
   void ledRedZone();
 
 private:
-  bool isPro_{};    // performance dashboard
-  bool inRed_{};    // rpm currently in red zone
-  int frameCnt_{};  // count blink duration
+  bool isPro_{};   // performance dashboard
+  bool inRed_{};   // rpm currently in red zone
+  int lastLap_{};  // msec, to detect a completed lap
+  int bestLap_{};  // msec, before the last lap
 };
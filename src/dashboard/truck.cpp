@@ -17,6 +17,7 @@
 #include "../utils.hpp"
 
 void TruckDashboard::updateEta(const TruckState *state) {
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   auto etaDist = min(state->etaDist, 9999);
   LAZY_UPDATE(etaDist, {
     disp_.setCursor(8, 0);
@@ -36,12 +37,14 @@ void TruckDashboard::updateEta(const TruckState *state) {
 }
 
 void TruckDashboard::updateSpeed(const TruckState *state) {
+  disp_.setPriority(Display::Priority::CRITICAL);
   auto speed = min(state->speed, 199);
   LAZY_UPDATE(speed, {
     disp_.printLarge(5, 1, speed, 3, false);
     DEBUG("Update speed: %d\n", speed);
   });
 
+  disp_.setPriority(Display::Priority::NORMAL, INFO_STALE);
   auto cruise = min(state->cruise, 999);
   LAZY_UPDATE(cruise, {
     disp_.setCursor(1, 2);
@@ -71,6 +74,7 @@ void TruckDashboard::updateSpeed(const TruckState *state) {
 }
 
 void TruckDashboard::updateFuel(const TruckState *state) {
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   auto fuelDist = min(state->fuelDist, 9999);
   LAZY_UPDATE(fuelDist, {
     dispPrintf(16, 3, "%4d", fuelDist);
@@ -78,13 +82,9 @@ void TruckDashboard::updateFuel(const TruckState *state) {
   });
 
   auto fuel = min(state->fuel, 100);
-  int seg = round(fuel / (100.0 / 10));
-  LAZY_UPDATE(seg, {
-    char bar[] = "\xA5\xA5\xA5\xA5\xA5\xA5\xA5\xA5\xA5\xA5";
-    for (int i = 0; i < seg; i++) {
-      bar[i] = 0xFF;
-    }
-    dispPrint(5, 3, bar);
+  int cols = round(fuel / (100.0 / (10 * BarGraph::CELL_COLS)));
+  LAZY_UPDATE(cols, {
+    disp_.printBar(5, 3, 10, cols, 0xA5);
     DEBUG("Update fuel: %d%%\n", fuel);
   });
 
@@ -94,6 +94,7 @@ void TruckDashboard::updateFuel(const TruckState *state) {
 }
 
 void TruckDashboard::updateClock(time_t time) {
+  disp_.setPriority(Display::Priority::MINOR, INFO_STALE);
   int h = CLOCK_12H ? hourFormat12(time) : hour(time),
       m = minute(time);
   LAZY_UPDATE(h, dispPrintf(0, 0, "%02d", h));
@@ -175,16 +176,22 @@ void TruckDashboard::dashboardInit() {
   dispPrint(0, 3, "                    ");
 }
 
-void TruckDashboard::fresh(void *owner, time_t time, const TruckState *state) {
-  // owner change needs a full update
-  force_ = disp_.setOwner(owner);
-  blinkShow_ = !blinkShow_;  // 1Hz @ 2FPS
+// the free cell between the clock and the ETA
+void TruckDashboard::updateStale(bool stale) {
+  disp_.setPriority(Display::Priority::NORMAL, INFO_STALE);
+  LAZY_UPDATE(stale, dispPrint(5, 0, stale ? "!" : " "));
+}
+
+void TruckDashboard::fresh(void *owner, time_t time, const TruckState *state, bool stale) {
+  // owner change needs a full update, unless the last screen is restored
+  force_ = disp_.setOwner(owner, this);
+  blinkShow_ = (millis() / 500) % 2 == 0;  // 1Hz, in phase after a skipped frame
 
   // no backlight when engine off, dim when headlight on
   int backLight = state->headlight ? BACKLIGHT_NIGHT : BACKLIGHT_DAY;
   disp_.backlightUpdate(force_, state->on ? backLight : BACKLIGHT_OFF);
   int ledLight = state->headlight ? RGB_LEVEL_NIGHT : RGB_LEVEL_DAY;
-  bool freshLed = disp_.ledBrightnesslUpdate(force_, state->on ? ledLight : RGB_LEVEL_OFF);
+  disp_.ledBrightnesslUpdate(force_, state->on ? ledLight : RGB_LEVEL_OFF);
 
   dashboardInit();
   if (CLOCK_ENABLE) {
@@ -193,8 +200,7 @@ void TruckDashboard::fresh(void *owner, time_t time, const TruckState *state) {
   updateSpeed(state);
   updateEta(state);
   updateFuel(state);
-
-  // dynamic RGB brightness change needs a full update (workaround for NeoPixel limitation)
-  force_ |= freshLed;
+  updateStale(stale);
+  disp_.flush(TRUCK_FLUSH_BUDGET);
   updateLEDs(state);
 }
@@ -47,11 +47,15 @@ public:
   TruckDashboard(Display &display)
     : Dashboard(display){};
 
-  void fresh(void *owner, time_t time, const TruckState *state);
+  void fresh(void *owner, time_t time, const TruckState *state, bool stale);
 
 public:
   static constexpr int FPS = 2;  // must be called @ 2FPS
 
+private:
+  // frames the fields may be delayed by the flush budget
+  static constexpr uint16_t INFO_STALE = FPS;  // 1s
+
 private:
   void dashboardInit();
   void updateSpeed(const TruckState *state);
@@ -59,4 +63,5 @@ private:
   void updateFuel(const TruckState *state);
   void updateLEDs(const TruckState *state);
   void updateClock(time_t time);
+  void updateStale(bool stale);
 };
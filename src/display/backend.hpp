@@ -0,0 +1,40 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct RgbColor {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+};
+
+// The hardware under Display: the I2C bus of the LCD, the LCD backlight PWM,
+// and the RGB LED strip. EspBackend drives the real ones, VirtualLcd emulates
+// them on the host.
+class DisplayBackend {
+public:
+  virtual ~DisplayBackend() {}
+
+  virtual void begin() = 0;
+
+  // one I2C write transaction, false on bus error
+  virtual bool i2cWrite(uint8_t addr, const uint8_t *data, size_t len) = 0;
+
+  // free a stuck bus and restart the controller
+  virtual void i2cRecover() {}
+
+  virtual void backlight(int level) = 0;
+
+  // the pixels in strip order, unscaled, and the brightness to apply
+  virtual void ledShow(const RgbColor *pixels, size_t count, uint8_t level) = 0;
+};
@@ -0,0 +1,51 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "bar_graph.hpp"
+#include "display.hpp"
+
+#define BAR_GLYPH(row) { row, row, row, row, row, row, row, row }
+
+// 1 to 4 columns filled
+static constexpr uint8_t LEFT_BARS[][8]{
+  BAR_GLYPH(0b10000),
+  BAR_GLYPH(0b11000),
+  BAR_GLYPH(0b11100),
+  BAR_GLYPH(0b11110),
+};
+static constexpr uint8_t RIGHT_BARS[][8]{
+  BAR_GLYPH(0b00001),
+  BAR_GLYPH(0b00011),
+  BAR_GLYPH(0b00111),
+  BAR_GLYPH(0b01111),
+};
+
+static constexpr uint8_t FULL = 0xFF;
+
+BarGraph::BarGraph(Display &disp)
+  : disp_(disp) {}
+
+void BarGraph::print(int x, int y, int cells, int cols, uint8_t empty, bool reverse) {
+  cells = constrain(cells, 0, LCD_COLS);  // a row at most
+  cols = constrain(cols, 0, cells * CELL_COLS);
+  int full = cols / CELL_COLS, part = cols % CELL_COLS;
+
+  // the cells from the filled end
+  uint8_t bar[LCD_COLS];
+  for (int i = 0; i < cells; i++) {
+    bar[i] = (i < full) ? FULL : empty;
+  }
+  if (part > 0) {
+    const uint8_t *glyph = reverse ? RIGHT_BARS[part - 1] : LEFT_BARS[part - 1];
+    bar[full] = disp_.glyph(glyph, (part * 2 >= CELL_COLS) ? FULL : empty);
+  }
+
+  disp_.setCursor(x, y);
+  for (int i = 0; i < cells; i++) {
+    disp_.write(bar[reverse ? cells - 1 - i : i]);
+  }
+}
@@ -0,0 +1,27 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <cstdint>
+
+class Display;
+
+// Horizontal bar graph in pixel columns, the partially filled cell is a
+// custom glyph, or rounded to a whole cell if no CGRAM slot is free.
+class BarGraph {
+public:
+  static constexpr int CELL_COLS = 5;  // pixel columns of a cell
+
+  BarGraph(Display &disp);
+
+  // fill cols of the cells, from the right if reverse
+  void print(int x, int y, int cells, int cols, uint8_t empty, bool reverse);
+
+private:
+  Display &disp_;
+};
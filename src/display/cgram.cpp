@@ -0,0 +1,93 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "cgram.hpp"
+
+uint8_t Cgram::get(Bitmap bitmap, int fallback) {
+  for (int i = 0; i < SLOTS; i++) {
+    auto &s = slots_[i];
+    if (s.glyph.bitmap == bitmap) {
+      s.glyph.fallback = fallback;
+      s.usedAt = frame_;
+      s.pinned = true;
+      return i;
+    }
+  }
+
+  int i = victim(fallback < 0);
+  if (i < 0) {
+    return (fallback < 0) ? ' ' : fallback;  // all taken by the glyphs without fallback
+  }
+  slots_[i] = { { bitmap, static_cast<int16_t>(fallback) }, frame_, true, true };
+  return i;
+}
+
+// A free slot, the least recently used one not in the framebuffer. Or else
+// the least recently used glyph with fallback if evict, with its cells
+// replaced by the fallback.
+int Cgram::victim(bool evict) {
+  int cnt[SLOTS]{};
+  for (size_t i = 0; i < cells_; i++) {
+    if (fb_[i] < SLOTS) {
+      cnt[fb_[i]]++;
+    }
+  }
+
+  int unused = -1, soft = -1;
+  for (int i = 0; i < SLOTS; i++) {
+    const auto &s = slots_[i];
+    if (s.pinned) {
+      continue;
+    }
+    if (s.glyph.bitmap == nullptr) {
+      return i;
+    }
+    if (cnt[i] == 0) {
+      if (unused < 0 || static_cast<int32_t>(s.usedAt - slots_[unused].usedAt) < 0) {
+        unused = i;
+      }
+    } else if (s.glyph.fallback >= 0) {
+      if (soft < 0 || static_cast<int32_t>(s.usedAt - slots_[soft].usedAt) < 0) {
+        soft = i;
+      }
+    }
+  }
+  if (unused >= 0 || !evict || soft < 0) {
+    return unused;
+  }
+
+  for (size_t i = 0; i < cells_; i++) {
+    if (fb_[i] == soft) {
+      fb_[i] = slots_[soft].glyph.fallback;
+    }
+  }
+  return soft;
+}
+
+void Cgram::invalidate() {
+  for (auto &s : slots_) {
+    s.dirty = (s.glyph.bitmap != nullptr);
+  }
+}
+
+void Cgram::save(Glyph (&out)[SLOTS]) const {
+  for (int i = 0; i < SLOTS; i++) {
+    out[i] = slots_[i].glyph;
+  }
+}
+
+// reload the slots changed since save()
+void Cgram::restore(const Glyph (&in)[SLOTS]) {
+  for (int i = 0; i < SLOTS; i++) {
+    auto &s = slots_[i];
+    if (s.glyph.bitmap != in[i].bitmap) {
+      s.dirty = (in[i].bitmap != nullptr);
+    }
+    s.glyph = in[i];
+    s.usedAt = frame_;
+  }
+}
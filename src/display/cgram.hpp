@@ -0,0 +1,86 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// HD44780 custom character slots, shared by the glyphs on demand. A glyph is
+// in use as long as its char code is in the framebuffer, the unused ones are
+// evicted (least recently used first) for the new ones. CGRAM is only written
+// when a glyph is not loaded, as each load is a 9 bytes I2C burst.
+class Cgram {
+public:
+  static constexpr int SLOTS = 8;
+
+  // 8 rows of 5 pixels, in static storage as it's identified by the address
+  using Bitmap = const uint8_t *;
+
+  struct Glyph {
+    Bitmap bitmap;
+    int16_t fallback;  // char code to show if evicted, -1 for never evicted
+  };
+
+  Cgram(uint8_t *fb, size_t cells)
+    : fb_(fb), cells_(cells) {}
+
+  // The char code of the glyph, to be written to the framebuffer before the
+  // next sync(). A glyph without fallback may evict the ones with, and their
+  // cells are replaced by the fallback. A glyph with fallback gets the
+  // fallback if no slot can be spared.
+  uint8_t get(Bitmap bitmap, int fallback = -1);
+
+  // load the changed slots with load(slot, bitmap)
+  template <typename F>
+  int sync(F &&load) {
+    int loads = 0;
+    for (int i = 0; i < SLOTS; i++) {
+      auto &s = slots_[i];
+      if (s.dirty) {
+        load(i, s.glyph.bitmap);
+        s.dirty = false;
+        loads++;
+      }
+      s.pinned = false;
+    }
+    loads_ += loads;
+    frame_++;
+    return loads;
+  }
+
+  // the glyph table to restore with a saved framebuffer
+  void save(Glyph (&out)[SLOTS]) const;
+  void restore(const Glyph (&in)[SLOTS]);
+
+  // reload all the glyphs, e.g. the LCD is reset
+  void invalidate();
+
+  // all the CGRAM slots loaded since boot
+  inline uint32_t loads() const {
+    return loads_;
+  }
+
+private:
+  int victim(bool evict);
+
+private:
+  struct Slot {
+    Glyph glyph;
+    uint32_t usedAt;  // frame
+    bool pinned;      // got in this frame, may be not in the framebuffer yet
+    bool dirty;       // to load
+  };
+
+  uint8_t *fb_;
+  size_t cells_;
+  Slot slots_[SLOTS]{};
+  uint32_t frame_{};
+  uint32_t loads_{};
+};
@@ -6,58 +6,326 @@
 // See the COPYING file in the top-level directory.
 
 #include "display.hpp"
+#include <cstring>
 #include "../utils.hpp"
 
-Display::Display(int lcdSDA, int lcdSCL, int lcdFreq, int lcdPWM, int rgbLedPin, int lcdAddr)
-  : lcdSda_(lcdSDA),
-    lcdScl_(lcdSCL),
-    lcdFreq_(lcdFreq),
-    lcdPwm_(lcdPWM),
-    rgbLedPin_(rgbLedPin),
+static constexpr int LCD_BENCHMARK_ROUNDS = 100;
+static constexpr int CGRAM_LOAD_BYTES = 1 + 8;  // set address + bitmap
+
+static_assert(static_cast<int>(Display::Layer::SYSTEM) < Overlays::LAYERS, "Not enough overlay layers");
+
+Display::Display(DisplayBackend &backend, int lcdAddr)
+  : backend_(backend),
     lcdAddr_(lcdAddr),
-    lcd_(LiquidCrystal_I2C(lcdAddr_, 20, 4)),
-    digit_(LargeDigit(lcd_)),
-    rgb_(Adafruit_NeoPixel(RGB_LED_NUM, rgbLedPin_, NEO_GRB + NEO_KHZ800)) {}
+    bus_(backend),
+    lcd_(LcdI2c(bus_, lcdAddr_)),
+    digit_(LargeDigit(*this)),
+    bar_(BarGraph(*this)) {}
 
 void Display::start() {
-  pinMode(lcdPwm_, OUTPUT);
-  pinMode(rgbLedPin_, OUTPUT);
+  backend_.begin();
 
   // RGB LED bar
-  rgb_.begin();
   ledBrightnesslUpdate(true, RGB_LEVEL_DAY);
   ledOFF();
+  ledFlush();
 
   // I2C LC2004
-  Wire.begin(lcdSda_, lcdScl_, lcdFreq_);
-  lcd_.init();
-  lcd_.backlight();
+  bus_.onRecover([this]() {
+    lcdLost_ = true;
+  });
+  lcd_.begin();
+  lcd_.backlight(true);
   backlightUpdate(true, BACKLIGHT_MAX);
+  if (LCD_BENCHMARK) {
+    Serial.printf("LCD throughput: %u bytes/s\n", static_cast<unsigned>(lcd_.benchmark(LCD_BENCHMARK_ROUNDS)));
+  }
   lcd_.clear();
-  digit_.begin();
+  fbReset();
 
   // display initial info
-  lcd_.setCursor(0, 1);
-  lcd_.print("    LCD Dashboard   ");
-  lcd_.setCursor(0, 2);
-  lcd_.print(" Forza \xA5 DiRT \xA5 ETS2");
+  setCursor(0, 1);
+  print("    LCD Dashboard   ");
+  setCursor(0, 2);
+  print(" Forza \xA5 DiRT \xA5 ETS2");
+  flush();
+  bus_.drain();  // the bus task is not running yet
+}
+
+// sync with a cleared LCD
+void Display::fbReset() {
+  memset(fb_, ' ', sizeof(fb_));
+  memset(glass_, ' ', sizeof(glass_));
+  fbPos_ = 0;
+  lcdPos_ = 0;
+}
+
+// the LCD may be garbled after a bus recovery, init again and resend all
+void Display::lcdReset() {
+  busDropped_ = bus_.dropped();
+
+  // a single write to see if the bus is back, before the blocking init
+  lcd_.backlight(true);
+  bus_.drain();
+  if (bus_.dropped() != busDropped_) {
+    return;  // still dead, retry once the bus is ready
+  }
+  uint32_t recoveries = bus_.recoveries();
+  lcd_.begin();
+  bus_.drain();  // on the glass, or dropped
+  if (bus_.dropped() != busDropped_ || bus_.recoveries() != recoveries) {
+    return;  // lost again, retry on the next flush
+  }
+  lcdLost_ = false;
+  memset(glass_, ' ', sizeof(glass_));
+  lcdPos_ = 0;
+  cgram_.invalidate();
+}
+
+void Display::createChar(uint8_t slot, const uint8_t *bitmap) {
+  lcd_.createChar(slot, bitmap);
+  lcdPos_ = -1;  // address counter now points to CGRAM
+}
+
+// Send the changed cells to the LCD in budget, the critical and overdue ones
+// first, then the others by priority. Unsent cells are left to the next
+// flush. The output after a flush is critical again unless told otherwise.
+void Display::flush(int budget) {
+  // the transactions dropped on a dead bus never reached the glass
+  if (bus_.dropped() != busDropped_) {
+    lcdLost_ = true;
+  }
+  if (lcdLost_ && bus_.ready()) {
+    lcdReset();  // not on a dead bus, the init would block for nothing
+  }
+
+  unsigned long now = millis();
+  for (int i = 0; i < Overlays::LAYERS; i++) {
+    if (overlays_.expired(i, now)) {
+      overlayHide(static_cast<Layer>(i));
+    }
+  }
+
+  // the glyphs first, they are in use once in the framebuffer
+  flushBytes_ = CGRAM_LOAD_BYTES * cgram_.sync([this](int slot, Cgram::Bitmap bitmap) {
+    createChar(slot, bitmap);
+  });
+
+  // a field is sent or deferred as a whole, the grouping holds for all passes
+  Fields fields;
+  groupFields(fields);
+  flushPass(Priority::CRITICAL, 0, fields);
+  flushPass(Priority::NORMAL, budget, fields);
+  flushPass(Priority::MINOR, budget, fields);
+  frame_++;
+
+  // the fields still pending were all deferred by the budget
+  for (int i = 0; budget > 0 && i < LCD_CELLS; i++) {
+    deferred_ += (fields.head[i] == i && screenAt(i) != glass_[i]);
+  }
+  setPriority(Priority::CRITICAL);
+
+  if (switched_) {
+    switched_ = false;
+    switchBytes_ = flushBytes_;
+    switches_++;
+    DEBUG("Mode switch: %d LCD bytes (%d on I2C)%s\n", switchBytes_,
+          switchBytes_ * static_cast<int>(LcdI2c::I2C_PER_BYTE), restored_ ? ", restored" : "");
+  }
+}
+
+// Group the changed cells by field, in one sweep, with the cost to send each
+// field at most: a setCursor and the data of each continuous segment.
+void Display::groupFields(Fields &fields) const {
+  uint8_t heads[LCD_CELLS];  // of the fields found so far
+  int count = 0;
+  for (int j = 0; j < LCD_CELLS; j++) {
+    fields.head[j] = Fields::NONE;
+    if (overlays_.top(j) >= 0 || screenAt(j) == glass_[j]) {
+      continue;
+    }
+
+    int h = count - 1;  // most likely the last one
+    while (h >= 0 && field_[heads[h]] != field_[j]) {
+      h--;
+    }
+    if (h < 0) {
+      heads[count++] = j;
+      fields.bytes[j] = 0;
+    }
+    uint8_t head = (h < 0) ? j : heads[h];
+    fields.head[j] = head;
+    fields.bytes[head] += (j > 0 && fields.head[j - 1] == head) ? 1 : 2;
+  }
+}
+
+// Send the cells due in this pass, in budget if not 0. A field due is sent as
+// a whole, or deferred as a whole if over the budget, a later smaller one may
+// fit. The overlays are critical, not part of the fields. Neighbouring picks
+// separated by short gaps are merged into one run, resending what the gaps
+// show, and setCursor is skipped when the LCD address counter already points
+// to the start of the run.
+void Display::flushPass(Priority pass, int budget, const Fields &fields) {
+  int8_t pick[LCD_CELLS]{};  // 1 to send, -1 deferred
+  int planned = flushBytes_;
+  for (int i = 0; i < LCD_CELLS; i++) {
+    if (pick[i] != 0 || !flushDue(i, pass)) {
+      continue;
+    }
+    if (overlays_.top(i) >= 0) {
+      pick[i] = 1;
+      planned += 2;
+      continue;
+    }
+
+    uint8_t head = fields.head[i];
+    bool fit = budget == 0 || planned + fields.bytes[head] <= budget;
+    for (int j = head; j < LCD_CELLS; j++) {
+      pick[j] = (fields.head[j] == head) ? (fit ? 1 : -1) : pick[j];
+    }
+    planned += fit ? fields.bytes[head] : 0;
+  }
+
+  int i = 0;
+  while (i < LCD_CELLS) {
+    if (pick[i] <= 0) {
+      i++;
+      continue;
+    }
+
+    int end = i + 1;
+    for (int j = end, gap = 0; j < LCD_CELLS && gap <= FLUSH_MERGE_GAP; j++) {
+      if (pick[j] > 0) {
+        end = j + 1;
+        gap = 0;
+      } else {
+        gap++;
+      }
+    }
+
+    uint8_t run[LCD_CELLS];
+    for (int j = i; j < end; j++) {
+      run[j - i] = (pick[j] > 0) ? screenAt(j) : glass_[j];
+    }
+    int cost = (lcdPos_ != i) + (end - i);
+
+    if (lcdPos_ != i) {
+      lcd_.setCursor(cellCol(i), cellRow(i));
+    }
+    lcd_.write(run, end - i);
+    memcpy(&glass_[i], run, end - i);
+    flushBytes_ += cost;
+    lcdPos_ = end % LCD_CELLS;
+    i = end;
+  }
+}
+
+uint32_t Display::deferredFields() {
+  uint32_t deferred = deferred_;
+  deferred_ = 0;
+  return deferred;
+}
+
+void Display::overlay(Layer layer, int x, int y, const char *text, unsigned long timeout) {
+  int i = static_cast<int>(layer);
+  overlayHide(layer);  // may be moved
+
+  int len = min(static_cast<int>(strlen(text)), LCD_COLS - constrain(x, 0, LCD_COLS - 1));
+  overlays_.show(i, cellIndex(x, y), text, len, timeout > 0, millis() + timeout);
+  DEBUG("Show overlay %d: %s\n", i, text);
+}
+
+// the cells under the box are sent with the critical ones, as the LCD has
+// been showing the box instead of them
+void Display::overlayHide(Layer layer) {
+  int i = static_cast<int>(layer);
+  const auto &box = overlays_.box(i);
+  if (!box.shown) {
+    return;
+  }
+  for (int j = box.start; j < box.start + box.len; j++) {
+    prio_[j] = Priority::CRITICAL;
+  }
+  overlays_.hide(i);
+}
+
+Display::Scene *Display::sceneOf(const void *painter) {
+  Scene *free = nullptr;
+  for (auto &scene : scenes_) {
+    if (scene.painter == painter) {
+      return &scene;
+    }
+    if (scene.painter == nullptr && free == nullptr) {
+      free = &scene;
+    }
+  }
+  return free;  // nullptr if all taken, never restored
+}
+
+void Display::sceneSave(Scene &scene) {
+  scene.painter = painter_;
+  scene.owner = owner_;
+  memcpy(scene.fb, fb_, sizeof(fb_));
+  memcpy(scene.leds, leds_, sizeof(leds_));
+  scene.ledLevel = ledLevel_;
+  cgram_.save(scene.glyphs);
+}
+
+void Display::sceneRestore(const Scene &scene) {
+  memcpy(fb_, scene.fb, sizeof(fb_));
+  memset(prio_, 0, sizeof(prio_));  // as a full redraw
+  cgram_.restore(scene.glyphs);
+  memcpy(leds_, scene.leds, sizeof(leds_));
+  ledLevel_ = scene.ledLevel;
+  ledShow();
+}
+
+bool Display::setOwner(void *owner, const void *painter) {
+  if (owner_ == owner && painter_ == painter) {
+    return false;
+  }
+
+  if (painter_ != nullptr) {
+    Scene *last = sceneOf(painter_);
+    if (last != nullptr) {
+      sceneSave(*last);
+    }
+  }
+
+  // The painter caches are only valid for the owner it drew last, e.g. the
+  // truck dashboard switching between ETS2 and ETS2 push needs a redraw.
+  Scene *next = sceneOf(painter);
+  bool redraw = (next == nullptr) || (next->owner != owner);
+  if (!redraw) {
+    sceneRestore(*next);
+  }
+
+  // the game notices are about the last owner
+  if (owner_ != owner) {
+    overlayHide(Layer::GAME);
+  }
+
+  owner_ = owner;
+  painter_ = painter;
+  switched_ = true;
+  restored_ = !redraw;
+  return redraw;
 }
 
 void Display::backlightUpdate(bool force, int level) {
   LAZY_EXEC(force, level, blLevel_, {
-    analogWrite(lcdPwm_, level);
+    backend_.backlight(level);
     DEBUG("Update backlight: %d\n", level);
   });
 }
 
-// NeoPixel brightness changes is lossy, the caller must redraw all the pixels
-// or the colors may be changed or lost after set.
+// the brightness is applied by the backend on the next ledFlush()
 bool Display::ledBrightnesslUpdate(bool force, uint8_t level) {
   bool changed = false;
 
   LAZY_EXEC(force, level, ledLevel_, {
     changed = true;
-    rgb_.setBrightness(level);
+    ledShow();
     DEBUG("Update LED brightness: %d\n", level);
   });
   return changed;
@@ -7,38 +7,110 @@
 
 #pragma once
 
-#include <Adafruit_NeoPixel.h>
-#include <LiquidCrystal_I2C.h>
 #include <Print.h>
 #include "../../board.h"
+#include "../display/backend.hpp"
+#include "../display/bar_graph.hpp"
+#include "../display/cgram.hpp"
+#include "../display/i2c_bus.hpp"
 #include "../display/large_digit.hpp"
-
-struct RgbColor {
-  uint8_t r;
-  uint8_t g;
-  uint8_t b;
-};
+#include "../display/lcd_i2c.hpp"
+#include "../display/overlay.hpp"
 
 // Facade for the entire display complex
 class Display : public Print {
 public:
-  Display(int lcdSDA, int lcdSCL, int lcdFreq, int lcdPWM, int rgbLedPin, int lcdAddr);
+  Display(DisplayBackend &backend, int lcdAddr);
 
   void start();
 
-  // LCD 2004
+  // LCD 2004: all the output goes to the shadow framebuffer, call flush() at
+  // the end of the frame to send the changes to the LCD.
   virtual inline size_t write(uint8_t val) {
-    return lcd_.write(val);
+    if (val != fb_[fbPos_] && fb_[fbPos_] == glass_[fbPos_]) {
+      due_[fbPos_] = frame_ + maxStale_;  // newly changed
+    }
+    prio_[fbPos_] = priority_;
+    field_[fbPos_] = fieldId_;
+    fb_[fbPos_] = val;
+    fbPos_ = (fbPos_ + 1) % LCD_CELLS;  // wrap like HD44780 address counter
+    return 1;
   }
 
   inline void printLarge(int x, int y, unsigned int num, int width, bool leadingZero) {
     digit_.print(x, y, num, width, leadingZero);
   }
 
+  // a stroke of the large digits, see LargeDigit
+  inline uint8_t largeStroke(int i) {
+    return digit_.stroke(i);
+  }
+
+  // fill cols pixel columns of the cells, see BarGraph
+  inline void printBar(int x, int y, int cells, int cols, uint8_t empty, bool reverse = false) {
+    bar_.print(x, y, cells, cols, empty, reverse);
+  }
+
+  // the char code of a custom glyph, loaded into CGRAM on the next flush
+  inline uint8_t glyph(Cgram::Bitmap bitmap, int fallback = -1) {
+    return cgram_.get(bitmap, fallback);
+  }
+
   inline void setCursor(uint8_t col, uint8_t row) {
-    lcd_.setCursor(col, row);
+    fbPos_ = cellIndex(col, row);
+  }
+
+  // Priority of the output until the next flush, which only matters if the
+  // flush has a budget: the critical cells are always sent, the others in
+  // priority order as long as the budget allows, or at most maxStale frames
+  // (flushes) later. Each call opens a field, the output until the next call,
+  // which is sent or deferred as a whole, never half updated on the glass.
+  enum class Priority : uint8_t {
+    CRITICAL,
+    NORMAL,
+    MINOR,
+  };
+
+  inline void setPriority(Priority priority, uint16_t maxStale = 0) {
+    priority_ = priority;
+    maxStale_ = maxStale;
+    fieldId_++;
+  }
+
+  // send the changes in budget LCD bytes, 0 for unlimited
+  void flush(int budget = 0);
+
+  // the last flush reached the LCD, to await before the next frame
+  inline bool flushed() const {
+    return bus_.idle();
   }
 
+  // the I2C transmit engine, to be run by the TaskRunner
+  inline Task &bus() {
+    return bus_;
+  }
+
+  // Overlay layers over the dashboards, the higher ones on top
+  enum class Layer : uint8_t {
+    GAME,    // of the current owner, hidden on owner change
+    SYSTEM,  // network and clock status
+  };
+
+  // Show text at (x, y) over the dashboards, clipped to the row, for timeout
+  // ms or until hidden if 0. The dashboard keeps drawing underneath, so its
+  // caches stay valid: the next flushes only send the covered cells, and the
+  // cells under the box once it is gone.
+  void overlay(Layer layer, int x, int y, const char *text, unsigned long timeout = 0);
+  void overlayHide(Layer layer);
+
+  // LCD bytes (commands + data) sent by the last flush
+  inline int flushBytes() const {
+    return flushBytes_;
+  }
+
+  // fields left to the next flushes by the budget, since the last call
+  uint32_t deferredFields();
+
   void backlightUpdate(bool force, int level);
 
   // RGB LEDs
@@ -48,19 +120,33 @@ public:
     if (i < 0 || i >= RGB_LED_NUM) {
       return;
     }
-    rgb_.setPixelColor(RGB_LED_NUM - i - 1, rgb_.Color(color.r, color.g, color.b));
+    leds_[RGB_LED_NUM - i - 1] = color;
   }
 
   inline void ledFill(const RgbColor &color) {
-    rgb_.fill(rgb_.Color(color.r, color.g, color.b));
+    for (auto &led : leds_) {
+      led = color;
+    }
   }
 
   inline void ledClear() {
-    rgb_.clear();
+    ledFill({ 0, 0, 0 });
   }
 
+  // the LEDs are sent on the next ledFlush(), at the LED refresh rate
   inline void ledShow() {
-    rgb_.show();
+    ledDirty_ = true;
+  }
+
+  inline bool ledDirty() const {
+    return ledDirty_;
+  }
+
+  inline void ledFlush() {
+    if (ledDirty_) {
+      backend_.ledShow(leds_, RGB_LED_NUM, ledLevel_);
+      ledDirty_ = false;
+    }
   }
 
   inline void ledOFF() {
@@ -68,33 +154,136 @@ public:
     ledShow();
   }
 
-  // return true on owner change
-  inline bool setOwner(void *owner) {
-    if (owner_ != owner) {
-      owner_ = owner;
-      return true;
-    }
-    return false;
-  }
+  // Hand the display to owner, drawn by painter (the dashboard). Returns true
+  // if the painter must redraw everything. The last screen and LEDs of each
+  // painter are kept, and restored when it is back for the same owner, since
+  // its caches still match them. The next flush then sends only the diff.
+  bool setOwner(void *owner, const void *painter);
 
   inline bool isOwnedBy(void *owner) const {
     return owner_ == owner;
   }
 
+  // LCD bytes sent by the first flush after the last owner change
+  inline int switchBytes() const {
+    return switchBytes_;
+  }
+
+  // the last owner change restored the screen, instead of a redraw
+  inline bool switchRestored() const {
+    return restored_;
+  }
+
+  // owner changes flushed
+  inline uint32_t switches() const {
+    return switches_;
+  }
+
+private:
+  // The framebuffer is kept in HD44780 DDRAM order (row 0, 2, 1, 3), so the
+  // cells are continuous in the same way as the LCD address counter.
+  static constexpr int LCD_CELLS = LCD_COLS * LCD_ROWS;
+  static_assert(LCD_COLS == 20 && LCD_ROWS == 4, "Only 2004 LCD is supported");
+
+  // unchanged cells to resend instead of a setCursor to skip them
+  static constexpr int FLUSH_MERGE_GAP = 1;
+
+  // the cell to display, from the top overlay or the framebuffer
+  inline uint8_t screenAt(int i) const {
+    int layer = overlays_.top(i);
+    return (layer < 0) ? fb_[i] : overlays_.at(layer, i);
+  }
+
+  // the changed cells to send in a flush pass, the overlays are critical
+  inline bool flushDue(int i, Priority pass) const {
+    int layer = overlays_.top(i);
+    uint8_t val = (layer < 0) ? fb_[i] : overlays_.at(layer, i);
+    return val != glass_[i] &&
+           (layer >= 0 || prio_[i] <= pass || static_cast<int16_t>(frame_ - due_[i]) >= 0);
+  }
+
+  // the pending fields of a flush, grouped once for all the passes
+  struct Fields {
+    static constexpr uint8_t NONE = 0xFF;  // not pending, or under an overlay
+
+    uint8_t head[LCD_CELLS];   // the first pending cell of the field of each cell
+    uint8_t bytes[LCD_CELLS];  // to send the field, at its head
+  };
+
+  void groupFields(Fields &fields) const;
+  void flushPass(Priority pass, int budget, const Fields &fields);
+
+  static inline int cellIndex(int col, int row) {
+    col = constrain(col, 0, LCD_COLS - 1);
+    row = constrain(row, 0, LCD_ROWS - 1);
+    return (row % 2) * (LCD_CELLS / 2) + (row / 2) * LCD_COLS + col;
+  }
+
+  static inline int cellCol(int idx) {
+    return idx % LCD_COLS;
+  }
+
+  static inline int cellRow(int idx) {
+    return (idx / (LCD_CELLS / 2)) + (idx % (LCD_CELLS / 2)) / LCD_COLS * 2;
+  }
+
+  void fbReset();
+  void lcdReset();
+  void createChar(uint8_t slot, const uint8_t *bitmap);
+
+  // the screen and LEDs left by a painter
+  static constexpr int MAX_PAINTERS = 3;  // clock, truck and racing
+
+  struct Scene {
+    const void *painter;
+    void *owner;
+    uint8_t fb[LCD_CELLS];
+    RgbColor leds[RGB_LED_NUM];
+    int ledLevel;
+    Cgram::Glyph glyphs[Cgram::SLOTS];
+  };
+
+  Scene *sceneOf(const void *painter);
+  void sceneSave(Scene &scene);
+  void sceneRestore(const Scene &scene);
+
 private:
-  int lcdSda_{};
-  int lcdScl_{};
-  int lcdFreq_{};
-  int lcdPwm_{};
-  int rgbLedPin_{};
+  DisplayBackend &backend_;
   int lcdAddr_{};
 
-  LiquidCrystal_I2C lcd_;
+  I2cBus bus_;
+  LcdI2c lcd_;
   LargeDigit digit_;
-  Adafruit_NeoPixel rgb_;
+  BarGraph bar_;
+  RgbColor leds_[RGB_LED_NUM]{};  // in strip order
 
   void *owner_{};
+  const void *painter_{};
+  Scene scenes_[MAX_PAINTERS]{};
+  bool switched_{};  // owner changed since the last flush
+  bool restored_{};  // and the screen was restored
+  int switchBytes_{};
+  uint32_t switches_{};
+
+  uint8_t fb_[LCD_CELLS]{};      // what the dashboards want to display
+  uint8_t glass_[LCD_CELLS]{};   // what is actually on the LCD
+  int fbPos_{};                  // framebuffer cursor
+  Priority prio_[LCD_CELLS]{};   // of the pending cells
+  uint16_t due_[LCD_CELLS]{};    // frame to send the pending cells at the latest
+  uint16_t field_[LCD_CELLS]{};  // of the pending cells, no wrap within maxStale
+  Priority priority_{};          // of the current output
+  uint16_t maxStale_{};
+  uint16_t fieldId_{};  // of the current output
+  uint16_t frame_{};
+  Cgram cgram_{ fb_, LCD_CELLS };
+  Overlays overlays_{};
+  int lcdPos_{ -1 };  // LCD address counter, -1 for unknown
+  int flushBytes_{};
+  uint32_t deferred_{};    // fields, since the last call
+  bool lcdLost_{};         // reset by the bus recovery
+  uint32_t busDropped_{};  // bus drops seen
 
   int blLevel_ = -1;
   int ledLevel_ = -1;
+  bool ledDirty_{};
 };
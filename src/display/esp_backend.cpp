@@ -0,0 +1,83 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "esp_backend.hpp"
+#include <Wire.h>
+
+static constexpr int RECOVER_CLOCKS = 9;  // a byte and the ACK
+static constexpr int HALF_CLOCK = 5;      // us, 100kHz
+
+EspBackend::EspBackend(int sda, int scl, uint32_t freq, int lcdPWM, int rgbLedPin, int rgbLedNum)
+  : sda_(sda),
+    scl_(scl),
+    freq_(freq),
+    lcdPwm_(lcdPWM),
+    rgbLedPin_(rgbLedPin),
+    rgb_(Adafruit_NeoPixel(rgbLedNum, rgbLedPin, NEO_GRB + NEO_KHZ800)) {}
+
+void EspBackend::begin() {
+  pinMode(lcdPwm_, OUTPUT);
+  pinMode(rgbLedPin_, OUTPUT);
+  rgb_.begin();
+  i2cBegin();
+}
+
+void EspBackend::i2cBegin() {
+  Wire.begin(sda_, scl_);
+  Wire.setClock(freq_);
+#ifdef ESP8266
+  Wire.setClockStretchLimit(XFER_TIMEOUT * 1000);  // us
+#else
+  Wire.setTimeOut(XFER_TIMEOUT);
+#endif
+}
+
+bool EspBackend::i2cWrite(uint8_t addr, const uint8_t *data, size_t len) {
+  Wire.beginTransmission(addr);
+  Wire.write(data, len);
+  return Wire.endTransmission() == 0;
+}
+
+// Clock out the byte a slave may be stuck in, until it releases SDA, then
+// generate a STOP and restart the controller.
+void EspBackend::i2cRecover() {
+#ifndef ESP8266
+  Wire.end();
+#endif
+  pinMode(sda_, INPUT_PULLUP);
+  pinMode(scl_, OUTPUT_OPEN_DRAIN);
+  digitalWrite(scl_, HIGH);
+  for (int i = 0; i < RECOVER_CLOCKS && digitalRead(sda_) == LOW; i++) {
+    digitalWrite(scl_, LOW);
+    delayMicroseconds(HALF_CLOCK);
+    digitalWrite(scl_, HIGH);
+    delayMicroseconds(HALF_CLOCK);
+  }
+
+  pinMode(sda_, OUTPUT_OPEN_DRAIN);
+  digitalWrite(sda_, LOW);
+  delayMicroseconds(HALF_CLOCK);
+  digitalWrite(scl_, HIGH);
+  delayMicroseconds(HALF_CLOCK);
+  digitalWrite(sda_, HIGH);
+  delayMicroseconds(HALF_CLOCK);
+
+  i2cBegin();
+}
+
+void EspBackend::backlight(int level) {
+  analogWrite(lcdPwm_, level);
+}
+
+// NeoPixel scales the colors on set, so the brightness goes first
+void EspBackend::ledShow(const RgbColor *pixels, size_t count, uint8_t level) {
+  rgb_.setBrightness(level);
+  for (size_t i = 0; i < count; i++) {
+    rgb_.setPixelColor(i, rgb_.Color(pixels[i].r, pixels[i].g, pixels[i].b));
+  }
+  rgb_.show();
+}
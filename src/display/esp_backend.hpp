@@ -0,0 +1,37 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Adafruit_NeoPixel.h>
+#include <Arduino.h>
+#include "backend.hpp"
+
+// Wire, PWM backlight and NeoPixel
+class EspBackend : public DisplayBackend {
+public:
+  EspBackend(int sda, int scl, uint32_t freq, int lcdPWM, int rgbLedPin, int rgbLedNum);
+
+  void begin() override;
+  bool i2cWrite(uint8_t addr, const uint8_t *data, size_t len) override;
+  void i2cRecover() override;
+  void backlight(int level) override;
+  void ledShow(const RgbColor *pixels, size_t count, uint8_t level) override;
+
+private:
+  void i2cBegin();
+
+private:
+  static constexpr uint16_t XFER_TIMEOUT = 10;  // ms, of each transaction
+
+  int sda_;
+  int scl_;
+  uint32_t freq_;
+  int lcdPwm_;
+  int rgbLedPin_;
+  Adafruit_NeoPixel rgb_;
+};
@@ -0,0 +1,115 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "i2c_bus.hpp"
+#include "../utils.hpp"
+
+void I2cBus::transmit(uint8_t addr, const uint8_t *data, size_t len) {
+  len = min(len, MAX_XFER);
+  if (!ready()) {
+    dropped_++;
+    return;
+  }
+  if (used_ + 2 + len > QUEUE_SIZE) {
+    drain();
+  }
+
+  size_t tail = (head_ + used_) % QUEUE_SIZE;
+  auto push = [&](uint8_t b) {
+    queue_[tail] = b;
+    tail = (tail + 1) % QUEUE_SIZE;
+  };
+  push(addr);
+  push(len);
+  for (size_t i = 0; i < len; i++) {
+    push(data[i]);
+  }
+  used_ += 2 + len;
+  wakeAt_ = now_;  // run on the next tick
+}
+
+void I2cBus::drain() {
+  while (used_ > 0) {
+    sendNext();
+  }
+}
+
+void I2cBus::run() {
+  TASK_BEGIN();
+  while (true) {
+    TASK_AWAIT_POLL(used_ > 0, IDLE_POLL);
+    sendNext();
+    TASK_YIELD();
+  }
+  TASK_END();
+}
+
+// pop and send the oldest transaction
+bool I2cBus::sendNext() {
+  auto pop = [this]() {
+    uint8_t b = queue_[head_];
+    head_ = (head_ + 1) % QUEUE_SIZE;
+    used_--;
+    return b;
+  };
+
+  uint8_t addr = pop(), len = pop();
+  uint8_t data[MAX_XFER];
+  for (size_t i = 0; i < len; i++) {
+    data[i] = pop();
+  }
+
+  if (send(addr, data, len)) {
+    return true;
+  }
+  recover();
+  if (send(addr, data, len)) {
+    return true;
+  }
+
+  // still stuck, drop the queue instead of stalling on each transaction
+  DEBUG("I2C bus is not responding, retry in %lums\n", RECOVER_BACKOFF);
+  dropped_++;
+  clearQueue();
+  dead_ = true;
+  retryAt_ = millis() + RECOVER_BACKOFF;
+  return false;
+}
+
+bool I2cBus::send(uint8_t addr, const uint8_t *data, size_t len) {
+  if (backend_.i2cWrite(addr, data, len)) {
+    if (dead_) {
+      // the devices missed the dropped transactions
+      dead_ = false;
+      DEBUG("I2C bus is back, dropped: %u\n", dropped_);
+      if (onRecover_) {
+        onRecover_();
+      }
+    }
+    return true;
+  }
+  errors_++;
+  return false;
+}
+
+void I2cBus::recover() {
+  backend_.i2cRecover();
+  recoveries_++;
+  DEBUG("I2C bus recovered, errors: %u\n", errors_);
+  if (onRecover_) {
+    onRecover_();
+  }
+}
+
+void I2cBus::clearQueue() {
+  while (used_ > 0) {
+    size_t len = queue_[(head_ + 1) % QUEUE_SIZE];
+    head_ = (head_ + 2 + len) % QUEUE_SIZE;
+    used_ -= 2 + len;
+    dropped_++;
+  }
+}
@@ -0,0 +1,96 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "backend.hpp"
+#include "../sched/task.hpp"
+
+// Queued I2C transmit engine. transmit() only copies the transaction into the
+// queue and returns, the task sends one transaction per tick, so the network
+// is served between them instead of after a whole frame.
+//
+// Each transaction is bounded by the backend timeout. On failure (e.g. SDA
+// held low by the PCF8574 after a brownout) the bus is recovered by the
+// backend, and the devices are told to re-initialize.
+class I2cBus : public Task {
+public:
+  using Callback = std::function<void()>;
+
+  explicit I2cBus(DisplayBackend &backend)
+    : Task("i2c"), backend_(backend) {}
+
+  // called after a bus recovery, and when a dead bus is back, the device
+  // state is unknown
+  inline void onRecover(Callback cb) {
+    onRecover_ = cb;
+  }
+
+  // Queue a transaction of at most MAX_XFER bytes. Waits for the queued ones
+  // if there is no room, so the latency is bounded by the queue size.
+  void transmit(uint8_t addr, const uint8_t *data, size_t len);
+
+  // send all the queued transactions now
+  void drain();
+
+  // all the queued transactions completed, to await before the next frame
+  inline bool idle() const {
+    return used_ == 0;
+  }
+
+  // transactions are accepted, not dropped: alive, or due to retry a dead bus
+  inline bool ready() const {
+    return !dead_ || Task::reached(millis(), retryAt_);
+  }
+
+  // statistics, dropped in transactions
+  inline uint32_t errors() const {
+    return errors_;
+  }
+
+  inline uint32_t recoveries() const {
+    return recoveries_;
+  }
+
+  inline uint32_t dropped() const {
+    return dropped_;
+  }
+
+public:
+  static constexpr size_t MAX_XFER = 128;  // Wire buffer size of both cores
+
+protected:
+  void run() override;
+
+private:
+  bool sendNext();
+  bool send(uint8_t addr, const uint8_t *data, size_t len);
+  void recover();
+  void clearQueue();
+
+private:
+  static constexpr size_t QUEUE_SIZE = 1024;              // a full repaint with CGRAM loads
+  static constexpr unsigned long RECOVER_BACKOFF = 1000;  // ms, on a dead bus
+  static constexpr unsigned long IDLE_POLL = 1000;        // ms, woken up by transmit()
+
+  DisplayBackend &backend_;
+  Callback onRecover_;
+
+  // ring of [addr, len, data...]
+  uint8_t queue_[QUEUE_SIZE]{};
+  size_t head_{};
+  size_t used_{};
+
+  unsigned long retryAt_{};  // transactions are dropped until then
+  bool dead_{};
+
+  uint32_t errors_{};
+  uint32_t recoveries_{};
+  uint32_t dropped_{};
+};
@@ -9,82 +9,82 @@
 // ref: https://coeleveld.com/bigfont/
 
 #include "large_digit.hpp"
+#include "display.hpp"
 #include "../utils.hpp"
 
-LargeDigit::LargeDigit(LiquidCrystal_I2C &lcd)
-  : lcd_(lcd) {}
+// loaded into CGRAM on demand
+static constexpr uint8_t STROKES[][8]{
+  [0] = { 0b11100,
+          0b11110,
+          0b11110,
+          0b11110,
+          0b11110,
+          0b11110,
+          0b11110,
+          0b11100 },
+  [1] = { 0b00111,
+          0b01111,
+          0b01111,
+          0b01111,
+          0b01111,
+          0b01111,
+          0b01111,
+          0b00111 },
+  [2] = { 0b11111,
+          0b11111,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b11111,
+          0b11111 },
+  [3] = { 0b11110,
+          0b11100,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b11000,
+          0b11100 },
+  [4] = { 0b01111,
+          0b00111,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00011,
+          0b00111 },
+  [5] = { 0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b11111,
+          0b11111 },
+  [6] = { 0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00111,
+          0b01111 },
+  [7] = { 0b11111,
+          0b11111,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000,
+          0b00000 }
+};
 
-void LargeDigit::begin() {
-  static constexpr uint8_t STROKES[][8]{
-    [0] = { 0b11100,
-            0b11110,
-            0b11110,
-            0b11110,
-            0b11110,
-            0b11110,
-            0b11110,
-            0b11100 },
-    [1] = { 0b00111,
-            0b01111,
-            0b01111,
-            0b01111,
-            0b01111,
-            0b01111,
-            0b01111,
-            0b00111 },
-    [2] = { 0b11111,
-            0b11111,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b11111,
-            0b11111 },
-    [3] = { 0b11110,
-            0b11100,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b11000,
-            0b11100 },
-    [4] = { 0b01111,
-            0b00111,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00011,
-            0b00111 },
-    [5] = { 0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b11111,
-            0b11111 },
-    [6] = { 0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00111,
-            0b01111 },
-    [7] = { 0b11111,
-            0b11111,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000,
-            0b00000 }
-  };
+LargeDigit::LargeDigit(Display &disp)
+  : disp_(disp) {}
 
-  for (int i = 0; i < (int)ARRAY_SIZE(STROKES); i++) {
-    lcd_.createChar(i, (uint8_t *)STROKES[i]);
-  }
+uint8_t LargeDigit::stroke(int i) {
+  return disp_.glyph(STROKES[i]);
 }
 
 void LargeDigit::writeDigit(int x, int y, int digit) {
@@ -113,17 +113,18 @@ void LargeDigit::writeDigit(int x, int y, int digit) {
   };
 
   for (int row = 0; row < CHAR_HEIGHT; row++) {
-    lcd_.setCursor(x, y + row);
+    disp_.setCursor(x, y + row);
     for (int i = 0; i < CHAR_WIDTH; i++) {
-      lcd_.write(FONT[digit][row][i]);
+      uint8_t c = FONT[digit][row][i];
+      disp_.write((c < ARRAY_SIZE(STROKES)) ? stroke(c) : c);
     }
   }
 }
 
 void LargeDigit::writeSpace(int x, int y) {
   for (int row = 0; row < CHAR_HEIGHT; row++) {
-    lcd_.setCursor(x, y + row);
-    lcd_.print("   ");
+    disp_.setCursor(x, y + row);
+    disp_.print("   ");
   }
 }
 
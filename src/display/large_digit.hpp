@@ -10,17 +10,21 @@
 
 #pragma once
 
-#include <LiquidCrystal_I2C.h>
+#include <cstdint>
+
+class Display;
 
 class LargeDigit {
 public:
-  LargeDigit(LiquidCrystal_I2C &lcd);
-  void begin();
+  LargeDigit(Display &disp);
   void clear(int x, int y, int count);
   void print(int x, int y, unsigned int num, int width, bool leadingZero);
 
+  // the char code of a stroke, for the letters drawn by the dashboards
+  uint8_t stroke(int i);
+
 private:
-  LiquidCrystal_I2C &lcd_;
+  Display &disp_;
   void writeDigit(int x, int y, int digit);
   void writeSpace(int x, int y);
 
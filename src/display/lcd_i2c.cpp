@@ -0,0 +1,130 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Unlike LiquidCrystal_I2C, which sends every nibble as its own Wire
+// transaction followed by fixed delays, the data bytes are packed into as few
+// transactions as possible. At 400kHz each PCF8574 write takes ~22us, so the
+// EN pulse width (>450ns) and the execution time of data writes and most
+// commands (37us, 2 PCF8574 writes apart) are already covered by the bus.
+//
+// The transactions are queued on the I2cBus and sent in background, except
+// in the init sequence and clear, which need the delays.
+
+#include "lcd_i2c.hpp"
+#include "../../board.h"
+
+static_assert(I2C_FREQ <= 400000, "Bus is too fast to cover the HD44780 timing");
+
+// PCF8574 pins
+static constexpr uint8_t PIN_RS = 0x01;
+static constexpr uint8_t PIN_EN = 0x04;
+static constexpr uint8_t PIN_BL = 0x08;
+
+// HD44780 commands
+static constexpr uint8_t CMD_CLEAR = 0x01;
+static constexpr uint8_t CMD_ENTRY_MODE = 0x06;    // increment, no shift
+static constexpr uint8_t CMD_DISPLAY_ON = 0x0C;    // no cursor, no blink
+static constexpr uint8_t CMD_FUNCTION_SET = 0x28;  // 4-bit, 2 lines, 5x8 dots
+static constexpr uint8_t CMD_SET_CGRAM = 0x40;
+static constexpr uint8_t CMD_SET_DDRAM = 0x80;
+
+static constexpr int CLEAR_DELAY = 2000;  // us, clear takes 1.52ms
+
+LcdI2c::LcdI2c(I2cBus &bus, uint8_t addr)
+  : bus_(bus), addr_(addr), backlight_(PIN_BL) {}
+
+// only in the init sequence, sent at once for the timing
+void LcdI2c::sendNibble(uint8_t nibble) {
+  uint8_t xfer[]{ static_cast<uint8_t>(nibble | backlight_ | PIN_EN), static_cast<uint8_t>(nibble | backlight_) };
+  bus_.transmit(addr_, xfer, sizeof(xfer));
+  bus_.drain();
+}
+
+void LcdI2c::send(const uint8_t *data, size_t len, uint8_t mode) {
+  while (len > 0) {
+    size_t n = min(len, BYTES_PER_XFER);
+
+    uint8_t xfer[BYTES_PER_XFER * I2C_PER_BYTE], *p = xfer;
+    for (size_t i = 0; i < n; i++) {
+      uint8_t hi = (data[i] & 0xF0) | mode | backlight_,
+              lo = ((data[i] << 4) & 0xF0) | mode | backlight_;
+      *p++ = hi | PIN_EN;
+      *p++ = hi;
+      *p++ = lo | PIN_EN;
+      *p++ = lo;
+    }
+    bus_.transmit(addr_, xfer, p - xfer);
+
+    data += n;
+    len -= n;
+  }
+}
+
+void LcdI2c::command(uint8_t cmd) {
+  send(&cmd, 1, 0);
+}
+
+void LcdI2c::write(const uint8_t *data, size_t len) {
+  send(data, len, PIN_RS);
+}
+
+void LcdI2c::begin() {
+  // power on reset and switch to 4-bit mode, refer to HD44780 datasheet
+  delay(50);
+  sendNibble(0x30);
+  delayMicroseconds(4500);
+  sendNibble(0x30);
+  delayMicroseconds(4500);
+  sendNibble(0x30);
+  delayMicroseconds(150);
+  sendNibble(0x20);
+
+  command(CMD_FUNCTION_SET);
+  command(CMD_DISPLAY_ON);
+  clear();
+  command(CMD_ENTRY_MODE);
+}
+
+void LcdI2c::backlight(bool on) {
+  backlight_ = on ? PIN_BL : 0;
+  bus_.transmit(addr_, &backlight_, 1);
+}
+
+void LcdI2c::clear() {
+  command(CMD_CLEAR);
+  bus_.drain();
+  delayMicroseconds(CLEAR_DELAY);
+}
+
+void LcdI2c::setCursor(uint8_t col, uint8_t row) {
+  static constexpr uint8_t ROW_OFFSETS[]{ 0x00, 0x40, 0x00 + LCD_COLS, 0x40 + LCD_COLS };
+  row = min(row, static_cast<uint8_t>(LCD_ROWS - 1));
+  command(CMD_SET_DDRAM | (ROW_OFFSETS[row] + col));
+}
+
+void LcdI2c::createChar(uint8_t slot, const uint8_t *bitmap) {
+  command(CMD_SET_CGRAM | ((slot & 0x7) << 3));
+  write(bitmap, 8);
+}
+
+uint32_t LcdI2c::benchmark(int rounds) {
+  uint8_t screen[LCD_COLS * LCD_ROWS];
+  for (size_t i = 0; i < sizeof(screen); i++) {
+    screen[i] = '0' + i % 10;
+  }
+
+  auto start = micros();
+  for (int i = 0; i < rounds; i++) {
+    setCursor(0, 0);
+    write(screen, sizeof(screen));  // DDRAM is continuous over all rows
+    bus_.drain();
+  }
+  auto elapsed = micros() - start;
+
+  uint64_t bytes = static_cast<uint64_t>(rounds) * (sizeof(screen) + 1);
+  return (elapsed > 0) ? bytes * 1000000 / elapsed : 0;
+}
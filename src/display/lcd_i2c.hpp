@@ -0,0 +1,50 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// HD44780 driver for the PCF8574 I2C daughter board, in 4-bit mode.
+//
+// PCF8574 pin map:
+//   P0: RS, P1: RW, P2: EN, P3: backlight, P4~P7: D4~D7
+
+#pragma once
+
+#include <Arduino.h>
+#include "i2c_bus.hpp"
+
+class LcdI2c {
+public:
+  LcdI2c(I2cBus &bus, uint8_t addr);
+
+  void begin();
+  void backlight(bool on);
+  void clear();
+  void setCursor(uint8_t col, uint8_t row);
+  void createChar(uint8_t slot, const uint8_t *bitmap);
+  void write(const uint8_t *data, size_t len);
+
+  inline void write(uint8_t val) {
+    write(&val, 1);
+  }
+
+  // measure the data throughput, returns bytes per second
+  uint32_t benchmark(int rounds);
+
+  // each HD44780 byte takes 2 nibbles x (EN high, EN low) PCF8574 writes
+  static constexpr size_t I2C_PER_BYTE = 4;
+
+private:
+  void command(uint8_t cmd);
+  void send(const uint8_t *data, size_t len, uint8_t mode);
+  void sendNibble(uint8_t nibble);
+
+private:
+  static constexpr size_t BYTES_PER_XFER = I2cBus::MAX_XFER / I2C_PER_BYTE;
+
+  I2cBus &bus_;
+  uint8_t addr_{};
+  uint8_t backlight_{};
+};
@@ -0,0 +1,21 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "overlay.hpp"
+#include <cstring>
+
+void Overlays::show(int layer, int start, const char *text, int len, bool timed, unsigned long until) {
+  len = (len < MAX_LEN) ? len : MAX_LEN;
+  memcpy(text_[layer], text, len);
+  boxes_[layer] = { start, len, true };
+  timed_[layer] = timed;
+  until_[layer] = until;
+}
+
+bool Overlays::expired(int layer, unsigned long now) const {
+  return boxes_[layer].shown && timed_[layer] && static_cast<long>(now - until_[layer]) >= 0;
+}
@@ -0,0 +1,66 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Text boxes over the framebuffer, one per layer, the higher layers on top.
+// They are composited on flush: a covered cell shows the top box, and the
+// framebuffer cell under it is kept to be shown again once the box is gone.
+class Overlays {
+public:
+  static constexpr int LAYERS = 2;
+  static constexpr int MAX_LEN = 20;  // a row
+
+  // the cells [start, start + len) of a layer
+  struct Box {
+    int start;
+    int len;
+    bool shown;
+  };
+
+  // show len chars of text over the cells from start, until the deadline if
+  // timed, truncated to MAX_LEN
+  void show(int layer, int start, const char *text, int len, bool timed, unsigned long until);
+
+  inline void hide(int layer) {
+    boxes_[layer].shown = false;
+  }
+
+  inline const Box &box(int layer) const {
+    return boxes_[layer];
+  }
+
+  // shown and timed out at now
+  bool expired(int layer, unsigned long now) const;
+
+  // the top layer covering the cell, -1 for none
+  inline int top(int cell) const {
+    for (int i = LAYERS - 1; i >= 0; i--) {
+      const Box &b = boxes_[i];
+      if (b.shown && cell >= b.start && cell < b.start + b.len) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // the char of a layer over the cell, which must be covered by it
+  inline uint8_t at(int layer, int cell) const {
+    return text_[layer][cell - boxes_[layer].start];
+  }
+
+private:
+  Box boxes_[LAYERS]{};
+  uint8_t text_[LAYERS][MAX_LEN]{};
+  bool timed_[LAYERS]{};
+  unsigned long until_[LAYERS]{};
+};
@@ -0,0 +1,200 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "virtual_lcd.hpp"
+#include <cstdio>
+#include <cstring>
+
+// HD44780 instructions, by the highest bit set
+static constexpr uint8_t CMD_CLEAR = 0x01;
+static constexpr uint8_t CMD_HOME = 0x02;
+static constexpr uint8_t CMD_ENTRY_MODE = 0x04;
+static constexpr uint8_t CMD_DISPLAY = 0x08;
+static constexpr uint8_t CMD_SHIFT = 0x10;
+static constexpr uint8_t CMD_FUNCTION_SET = 0x20;
+static constexpr uint8_t CMD_SET_CGRAM = 0x40;
+static constexpr uint8_t CMD_SET_DDRAM = 0x80;
+
+static constexpr uint8_t ENTRY_INCREMENT = 0x02;
+static constexpr uint8_t DISPLAY_ON = 0x04;
+static constexpr uint8_t FUNCTION_8BIT = 0x10;
+
+// the second line starts at 0x40, rows 2 and 3 continue rows 0 and 1
+static constexpr uint8_t ROW_OFFSETS[]{ 0x00, 0x40, 0x14, 0x54 };
+static constexpr uint8_t LINE_END = 0x27;
+static constexpr uint8_t LINE2 = 0x40;
+
+VirtualLcd::VirtualLcd(uint8_t addr, int ledNum)
+  : addr_(addr), ledNum_(ledNum < MAX_LEDS ? ledNum : MAX_LEDS) {
+  memset(ddram_, ' ', sizeof(ddram_));
+}
+
+bool VirtualLcd::i2cWrite(uint8_t addr, const uint8_t *data, size_t len) {
+  busBytes_ += 1 + len;  // the address byte
+  xfers_++;
+  if (addr != addr_) {
+    return false;  // NACK
+  }
+
+  for (size_t i = 0; i < len; i++) {
+    uint8_t pins = data[i];
+    if ((pins_ & PIN_EN) && !(pins & PIN_EN)) {
+      latch(pins_ & 0xF0, pins_ & PIN_RS);
+    }
+    pins_ = pins;
+  }
+  return true;
+}
+
+// D4~D7 of the bus, D0~D3 are not wired and read as 0 in 8-bit mode
+void VirtualLcd::latch(uint8_t nibble, bool rs) {
+  if (!fourBit_) {
+    execute(nibble, rs);
+    return;
+  }
+  if (!half_) {
+    high_ = nibble;
+    half_ = true;
+    return;
+  }
+  half_ = false;
+  execute(high_ | (nibble >> 4), rs);
+}
+
+void VirtualLcd::execute(uint8_t val, bool rs) {
+  if (!rs) {
+    command(val);
+    return;
+  }
+
+  if (cgMode_) {
+    cgram_[ac_ % CGRAM_SIZE] = val & 0x1F;
+    ac_ = (increment_ ? ac_ + 1 : ac_ - 1) & (CGRAM_SIZE - 1);
+  } else {
+    ddram_[ac_] = val;
+    step();
+  }
+}
+
+void VirtualLcd::command(uint8_t cmd) {
+  if (cmd & CMD_SET_DDRAM) {
+    ac_ = cmd & 0x7F;
+    cgMode_ = false;
+  } else if (cmd & CMD_SET_CGRAM) {
+    ac_ = cmd & 0x3F;
+    cgMode_ = true;
+  } else if (cmd & CMD_FUNCTION_SET) {
+    bool fourBit = !(cmd & FUNCTION_8BIT);
+    if (fourBit != fourBit_) {
+      fourBit_ = fourBit;
+      half_ = false;
+    }
+  } else if (cmd & CMD_SHIFT) {
+    // cursor/display shift, never used
+  } else if (cmd & CMD_DISPLAY) {
+    displayOn_ = cmd & DISPLAY_ON;
+  } else if (cmd & CMD_ENTRY_MODE) {
+    increment_ = cmd & ENTRY_INCREMENT;
+  } else if (cmd & CMD_HOME) {
+    ac_ = 0;
+    cgMode_ = false;
+  } else if (cmd & CMD_CLEAR) {
+    memset(ddram_, ' ', sizeof(ddram_));
+    ac_ = 0;
+    cgMode_ = false;
+    increment_ = true;
+  }
+}
+
+// the DDRAM address counter skips the gap between the two lines
+void VirtualLcd::step() {
+  if (increment_) {
+    ac_ = (ac_ == LINE_END) ? LINE2 : (ac_ == LINE2 + LINE_END) ? 0 : ac_ + 1;
+  } else {
+    ac_ = (ac_ == LINE2) ? LINE_END : (ac_ == 0) ? LINE2 + LINE_END : ac_ - 1;
+  }
+}
+
+void VirtualLcd::backlight(int level) {
+  blLevel_ = level;
+}
+
+void VirtualLcd::ledShow(const RgbColor *pixels, size_t count, uint8_t level) {
+  for (size_t i = 0; i < count && i < static_cast<size_t>(ledNum_); i++) {
+    leds_[i] = pixels[i];
+  }
+  ledLevel_ = level;
+}
+
+uint8_t VirtualLcd::cell(int col, int row) const {
+  if (col < 0 || col >= COLS || row < 0 || row >= ROWS) {
+    return ' ';
+  }
+  return ddram_[ROW_OFFSETS[row] + col];
+}
+
+RgbColor VirtualLcd::led(int i) const {
+  if (i < 0 || i >= ledNum_) {
+    return { 0, 0, 0 };
+  }
+  auto scale = [this](uint8_t c) {
+    return static_cast<uint8_t>(ledLevel_ == 255 ? c : (c * (ledLevel_ + 1)) >> 8);
+  };
+  return { scale(leds_[i].r), scale(leds_[i].g), scale(leds_[i].b) };
+}
+
+std::string VirtualLcd::frame() const {
+  std::string out;
+  bool used[8]{};
+  char buf[16];
+
+  std::string border = "+" + std::string(COLS, '-') + "+\n";
+  out += border;
+  for (int row = 0; row < ROWS; row++) {
+    out += '|';
+    for (int col = 0; col < COLS; col++) {
+      uint8_t c = cell(col, row);
+      if (c < 0x10) {
+        used[c & 0x7] = true;
+        out += static_cast<char>('0' + (c & 0x7));
+      } else if (c == 0xFF) {
+        out += '#';
+      } else if (c == 0xA5) {
+        out += '.';
+      } else {
+        out += (c >= 0x20 && c < 0x7F) ? static_cast<char>(c) : '?';
+      }
+    }
+    out += "|\n";
+  }
+  out += border;
+
+  for (int code = 0; code < 8; code++) {
+    if (!used[code]) {
+      continue;
+    }
+    snprintf(buf, sizeof(buf), "%d:", code);
+    out += buf;
+    for (int y = 0; y < 8; y++) {
+      out += ' ';
+      for (int x = 4; x >= 0; x--) {
+        out += (glyph(code)[y] >> x) & 1 ? '#' : '.';
+      }
+    }
+    out += '\n';
+  }
+
+  out += "LED";
+  for (int i = 0; i < ledNum_; i++) {
+    RgbColor c = led(i);
+    snprintf(buf, sizeof(buf), " %02x%02x%02x", c.r, c.g, c.b);
+    out += buf;
+  }
+  snprintf(buf, sizeof(buf), " BL %d%s\n", backlightOn() ? blLevel_ : 0, displayOn_ ? "" : " off");
+  out += buf;
+  return out;
+}
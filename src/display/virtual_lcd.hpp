@@ -0,0 +1,108 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "backend.hpp"
+
+// Headless 2004 HD44780 behind a PCF8574, and an LED strip. The I2C stream
+// is decoded like the real controller does: a nibble is latched on each EN
+// falling edge, the commands and data go to DDRAM or CGRAM by the address
+// counter. So what Display sends, including its cursor shortcuts, is what
+// ends up on the virtual glass.
+class VirtualLcd : public DisplayBackend {
+public:
+  static constexpr int COLS = 20;
+  static constexpr int ROWS = 4;
+  static constexpr int MAX_LEDS = 16;
+
+  VirtualLcd(uint8_t addr, int ledNum);
+
+  void begin() override {}
+  bool i2cWrite(uint8_t addr, const uint8_t *data, size_t len) override;
+  void backlight(int level) override;
+  void ledShow(const RgbColor *pixels, size_t count, uint8_t level) override;
+
+  // char code on the glass
+  uint8_t cell(int col, int row) const;
+
+  // 8 rows of 5 pixels of the custom char code (0~7)
+  inline const uint8_t *glyph(int code) const {
+    return &cgram_[(code & 0x7) * 8];
+  }
+
+  // LED color as shown, scaled by the brightness like NeoPixel does
+  RgbColor led(int i) const;
+
+  inline bool displayOn() const {
+    return displayOn_;
+  }
+
+  // PCF8574 backlight pin and the PWM level
+  inline bool backlightOn() const {
+    return pins_ & PIN_BL;
+  }
+
+  inline int backlightLevel() const {
+    return blLevel_;
+  }
+
+  // bus cost since begin: address + data bytes, and transactions
+  inline uint32_t busBytes() const {
+    return busBytes_;
+  }
+
+  inline uint32_t transactions() const {
+    return xfers_;
+  }
+
+  // The frame as text: the glass with the custom chars as their code and the
+  // block chars as '#' and '.', the glyphs in use, and the LED row in hex.
+  // Stable for the same screen, to be compared with golden frames.
+  std::string frame() const;
+
+private:
+  void latch(uint8_t nibble, bool rs);
+  void execute(uint8_t val, bool rs);
+  void command(uint8_t cmd);
+  void step();
+
+private:
+  static constexpr uint8_t PIN_RS = 0x01;
+  static constexpr uint8_t PIN_EN = 0x04;
+  static constexpr uint8_t PIN_BL = 0x08;
+  static constexpr int DDRAM_SIZE = 0x80;  // 0x00~0x27 and 0x40~0x67 in use
+  static constexpr int CGRAM_SIZE = 64;
+
+  uint8_t addr_;
+  int ledNum_;
+
+  uint8_t pins_{};  // PCF8574 output
+  bool fourBit_{};  // 8-bit on power up
+  bool half_{};     // the high nibble is latched
+  uint8_t high_{};
+
+  uint8_t ac_{};   // address counter
+  bool cgMode_{};  // pointing to CGRAM
+  bool increment_{ true };
+  bool displayOn_{};
+
+  uint8_t ddram_[DDRAM_SIZE]{};
+  uint8_t cgram_[CGRAM_SIZE]{};
+
+  int blLevel_{};
+  RgbColor leds_[MAX_LEDS]{};
+  uint8_t ledLevel_{};
+
+  uint32_t busBytes_{};
+  uint32_t xfers_{};
+};
@@ -0,0 +1,180 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Static dispatch of the games: the controller walks a tuple of the game
+// slots with fold expressions, and calls each game by its own (final) type,
+// so the calls are direct and can be inlined. The disabled slots are skipped
+// at compile time.
+
+#pragma once
+
+#include <tuple>
+#include "game.hpp"
+#include "registry.hpp"
+#include "../utils.hpp"
+#include "../sched/task.hpp"
+
+// The enabled games in the given order, the earlier ones are probed first.
+template <typename... Slots>
+class Controller : public ControllerBase {
+public:
+  static constexpr size_t COUNT = (0 + ... + (Slots::ENABLED ? 1 : 0));
+  static_assert(COUNT > 0, "No game enabled in config.h");
+
+  Controller(Display &disp, NtpClock &clock, Slots &...slots)
+    : ControllerBase(disp, clock, games_, COUNT), slots_(slots...) {
+    size_t n = 0;
+    forEach([this, &n](Game &game) { games_[n++] = &game; });
+  }
+
+  void tick() {
+    // the packets wake the ingest task, which wakes the controller once parsed
+    forEach([this](auto &game) {
+      if (game.arrived()) {
+        game.ingestWake();
+      }
+      if (game.published()) {
+        wake(game, millis());
+      }
+    });
+
+    // poll the game in play, or the games due to probe
+    if ((active_ != nullptr) ? poll_.due(millis()) : probeDue(millis())) {
+      pollGames();
+      updateState();
+    }
+
+    if (driving_) {
+      if (disp_.flushed() && render_.due(millis())) {  // the last frame is out
+        visit(active_, [this](auto &game) {
+          game.setStale(stale(game.pollDelay()));
+          game.freshDisplay(clock_.time());
+          rendered(game.name());
+        });
+      }
+    } else if (!clock_.inDisplay()) {
+      clock_.freshDisplay();  // need to switch to clock mode (not driving, or inactive)
+    }
+    // otherwise let clock_tick() to update the clock disp
+
+    if (leds_.due(millis())) {
+      disp_.ledFlush();
+    }
+    if (report_.due(millis())) {
+      report();
+    }
+  }
+
+  inline void startGames() {
+    online_ = true;
+    forEach([](auto &game) { game.start(); });
+  }
+
+  inline void stopGames() {
+    online_ = false;
+    forEach([](auto &game) { game.stop(); });
+  }
+
+  // the ingest tasks of the games, to be run by the runner
+  inline void addTasks(TaskRunner &tasks) {
+    forEach([&tasks](Game &game) { tasks.add(game.ingestTask()); });
+  }
+
+private:
+  // each enabled game, by its own type
+  template <typename F>
+  inline void forEach(F &&f) {
+    std::apply([&f](auto &...slots) { (each(slots, f), ...); }, slots_);
+  }
+
+  template <typename S, typename F>
+  static inline void each(S &slot, F &f) {
+    if constexpr (S::ENABLED) {
+      f(*slot.get());
+    }
+  }
+
+  // the given game, by its own type
+  template <typename F>
+  inline void visit(const Game *target, F &&f) {
+    forEach([target, &f](auto &game) {
+      if (&game == target) {
+        f(game);
+      }
+    });
+  }
+
+  template <typename G>
+  bool pollGame(G &game) {
+    state_ = game.getTelemetry();
+    return pollResult(game, game.name(), game.pollDelay());
+  }
+
+  template <typename G>
+  bool probeGame(G &game, unsigned long now) {
+    unsigned long start = micros();
+    bool found = pollGame(game);
+    if (probeMissed(game, now, micros() - start, found)) {
+      game.probeAt(game.probe_.next);
+    }
+    return found;
+  }
+
+  void pollGames() {
+    // poll current game
+    bool found = false;
+    visit(active_, [this, &found](auto &game) { found = pollGame(game); });
+    if (found) {
+      return;
+    }
+
+    // probe games, each at its own rate
+    unsigned long now = millis();
+    Game *next;
+    while (!found && (next = nextProbe(now)) != nullptr) {
+      visit(next, [this, now, &found](auto &game) { found = probeGame(game, now); });
+    }
+  }
+
+  // poll right away on the pushed data ingested, instead of waiting for the
+  // deadline, so the game is detected at once, and the frame is rendered with
+  // the freshest data.
+  template <typename G>
+  void wake(G &game, unsigned long now) {
+    if (active_ == nullptr) {
+      signal(game, now);
+    } else if (active_ == &game) {
+      // no faster than the frame rate, and in phase with the packets
+      poll_.wake(now, game.pollDelay());
+      render_.wake(now, game.FRAME_DELAY);
+    }  // else not interested in other games while playing
+  }
+
+  void report() {
+    if (!DEBUG_ENABLE) {
+      return;
+    }
+    reportSwitches();
+    if (!driving_) {
+      forEach([](auto &game) {
+        const auto &p = game.probe_;
+        DEBUG("%s probe every: %lums, cost: %luus, detected: %u, last: %lums, max: %lums\n",
+              game.name(), p.interval, p.costUs, p.detects, p.detectLast, p.detectMax);
+      });
+      return;
+    }
+    auto s = render_.stats();
+    visit(active_, [this, &s](auto &game) {
+      DEBUG("%s frames: %u, skipped: %u, late avg: %lums, max: %lums, deferred fields: %u\n",
+            game.name(), s.runs, s.skipped, s.lateAvg, s.lateMax, disp_.deferredFields());
+    });
+  }
+
+private:
+  std::tuple<Slots &...> slots_;
+  Game *games_[COUNT]{};  // the probe states, for the base
+};
@@ -10,7 +10,10 @@
 #include "../utils.hpp"
 
 DirtGame::DirtGame(RacingDashboard &dash, uint16_t port)
-  : Game(5 * RacingDashboard::FPS, 1000 / RacingDashboard::FPS), dash_(dash), port_(port) {}
+  : Game("dirt", 5 * RacingDashboard::FPS, 1000 / RacingDashboard::FPS, 1000 / RacingDashboard::FPS),
+    dash_(dash),
+    udp_(port, IsDirtPacket, UdpQueue::Read::LATEST),
+    rate_(ACTIVE_DELAY, ACTIVE_DELAY, RACING_POLL_SLOW) {}
 
 GameState DirtGame::dirtTelemetryParse(size_t len) {
   if (len != sizeof(CodemastersAPIv3)) {
@@ -21,52 +24,68 @@ GameState DirtGame::dirtTelemetryParse(size_t len) {
 
   // never touch state_ until we can confirm we will success, so we can display
   // previous state on temporary failure.
-  state_.speed = abs(round(KmConv((double)pkt->speed * 3600 / 1000)));
-  state_.gear = pkt->gear;
-  state_.rpmIdle = round(pkt->idle_rpm * 10);
-  state_.rpm = round(pkt->engine_rate * 10);
-  state_.rpmMax = round(pkt->max_rpm * 10);
-  state_.fuel = (pkt->fuel_capacity > FLT_EPSILON)
-                  ? round(pkt->fuel_in_tank * 100 / pkt->fuel_capacity)  // fuel available
-                  : 100;                                                 // not supported, always full
+  RacingState state = state_;
+  state.speed = abs(round(KmConv((double)pkt->speed * 3600 / 1000)));
+  state.gear = pkt->gear;
+  state.rpmIdle = round(pkt->idle_rpm * 10);
+  state.rpm = round(pkt->engine_rate * 10);
+  state.rpmPeak = round(rpmPeak_ * 10);
+  state.rpmMax = round(pkt->max_rpm * 10);
+  state.fuel = (pkt->fuel_capacity > FLT_EPSILON)
+                 ? round(pkt->fuel_in_tank * 100 / pkt->fuel_capacity)  // fuel available
+                 : 100;                                                 // not supported, always full
 
-  state_.lap = pkt->lap + 1;
-  state_.pos = pkt->race_position;
-  state_.lastLap = pkt->last_lap_time * 1000;
-  state_.currLap = pkt->lap_time * 1000;
+  state.lap = pkt->lap + 1;
+  state.pos = pkt->race_position;
+  state.lastLap = pkt->last_lap_time * 1000;
+  state.currLap = pkt->lap_time * 1000;
 
   // Codemasters will not send best lap data, so we have to calculate it by ourselves
-  if (state_.lastLap == 0) {
-    state_.bestLap = 0;  // new race, clear best lap
-  } else if (state_.lastLap < state_.bestLap || state_.bestLap == 0) {
-    state_.bestLap = state_.lastLap;
+  if (state.lastLap == 0) {
+    state.bestLap = 0;  // new race, clear best lap
+  } else if (state.lastLap < state.bestLap || state.bestLap == 0) {
+    state.bestLap = state.lastLap;
   }
 
-  state_.isPro = DIRT_PRO_STYLE;
+  state.isPro = DIRT_PRO_STYLE;
 
+  state_ = state;
   return GameState::DRIVING;
 }
 
-GameState DirtGame::getTelemetry() {
-  int len = udp_.parsePacket();
+void DirtGame::ingest() {
+  // decode the newest packet only, but never miss the rpm peak for shift lights
+  unsigned long now = millis();
+  int len = udp_.popLatest(pkt_.bytes, sizeof(pkt_), [this, now](int) {
+    float rpm = pkt_.apiV3.engine_rate;
+    if (rpm >= rpmPeak_ || now - peakAt_ >= static_cast<unsigned long>(FRAME_DELAY)) {
+      rpmPeak_ = rpm;
+      peakAt_ = now;
+    }
+  });
   if (len <= 0) {
-    return GameState::SERVER_DOWN;  // no packet
+    return;
   }
+  LAZY_EXEC(false, udp_.dropped(), dropped_,
+            DEBUG("%s packets dropped: %u, coalesced: %u\n", name(), udp_.dropped(), udp_.coalesced()));
+  GameState result = dirtTelemetryParse(len);
 
-  if (!IsDirtPacket(len)) {
-    Serial.printf("Invalid %s packet of size %d from %s\n", name(), len, udp_.remoteIP().toString().c_str());
-    return GameState::SERVER_DOWN;
-  }
+  // no race state in the packet, standing still at idle rpm is most likely paused
+  if (result == GameState::DRIVING) {
+    bool idle = (state_.speed == 0 && state_.rpm <= state_.rpmIdle);
+    rate_.sample(idle ? AdaptiveRate::Activity::IDLE : AdaptiveRate::Activity::STEADY);
+  }  // else state_ is the last one, not a sample
+  handoff_.publish(result, state_);
+}
 
-  int n = udp_.read(pkt_.bytes, sizeof(pkt_));
-  if (n != len) {
-    Serial.printf("Failed to read %s packet: %d of %d\n", name(), n, len);
-    return GameState::SERVER_DOWN;
+GameState DirtGame::getTelemetry() {
+  GameState result;
+  if (!handoff_.take(result)) {
+    return GameState::SERVER_DOWN;  // no packet
   }
-
-  return dirtTelemetryParse(n);
+  return result;
 }
 
 void DirtGame::freshDisplay([[maybe_unused]] time_t time) {
-  dash_.fresh(this, &state_);
+  dash_.fresh(this, handoff_.state(), stale_);
 }
@@ -8,12 +8,13 @@
 #pragma once
 
 #include <Arduino.h>
-#include <WiFiUdp.h>
 #include "dirt_udp.hpp"
 #include "game.hpp"
 #include "../dashboard/racing.hpp"
+#include "../net/udp_mux.hpp"
+#include "../sched/adaptive_rate.hpp"
 
-class DirtGame : public Game {
+class DirtGame final : public Game {
 public:
   DirtGame(RacingDashboard &dash, uint16_t port);
   GameState getTelemetry() override;
@@ -24,22 +25,43 @@ public:
   }
 
   inline void start() override {
-    Serial.printf("Listening %s telemetry on: %u\n", name(), port_);
-    udp_.begin(port_);
+    Serial.printf("Listening %s telemetry on: %u\n", name(), udp_.port());
+    udp_.begin();
   }
 
   inline void stop() override {
-    udp_.stop();
+    udp_.end();
   }
 
+  inline bool arrived() override {
+    return udp_.arrived();
+  }
+
+  inline bool published() override {
+    return handoff_.published();
+  }
+
+  inline unsigned long pollDelay() const override {
+    return rate_.delay();
+  }
+
+protected:
+  void ingest() override;
+
 private:
   GameState dirtTelemetryParse(size_t len);
 
 private:
   RacingDashboard &dash_;
-  uint16_t port_{};
+  TelemetryHandoff<RacingState> handoff_;
 
+  // ingest side
   RacingState state_{};
-  WiFiUDP udp_{};
-  DirtPkt pkt_{};  // packet buffer
+  // up to 100Hz, about 3 packets per frame
+  UdpQueueOf<sizeof(DirtPkt), 8> udp_;
+  DirtPkt pkt_{};           // packet buffer
+  float rpmPeak_{};         // held for a frame, not to be missed by the shift lights
+  unsigned long peakAt_{};  // of rpmPeak_
+  uint32_t dropped_{};      // the last reported
+  AdaptiveRate rate_;       // slower in menus
 };
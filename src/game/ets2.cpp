@@ -6,25 +6,16 @@
 // See the COPYING file in the top-level directory.
 
 #include "ets2.hpp"
-#include <ArduinoJson.h>
 #include <cfloat>
 #include <cstring>
-#include <TimeLib.h>
 #include "../utils.hpp"
+#include "../sched/idle.hpp"
 
-static constexpr int HTTP_CONN_TIMEOUT = 100;  // timeout for connect
-static constexpr int HTTP_READ_TIMEOUT = 200;  // timeout for TCP read
+// start the request ahead of the next poll, so the response is ready in time
+static constexpr unsigned long FETCH_LEAD = 300;
 
-// Calculated with: https://arduinojson.org/v6/assistant/
-static constexpr int JSON_FILTER_SIZE = 512;
-static constexpr int JSON_DOC_SIZE = 1024;
-
-// ISO8601: "0001-01-05T05:11:00Z"
-static int toMinutes(const char *date) {
-  struct tm tm {};
-  strptime(date, "%Y-%m-%dT%H:%M:%SZ", &tm);
-  return (tm.tm_yday * 24 + tm.tm_hour) * 60 + tm.tm_min + (tm.tm_sec < 30 ? 0 : 1);
-}
+// changes of the state to poll faster
+static constexpr double DYNAMIC_ACCEL = 4;  // km/h per second
 
 static bool isEV(const char *model) {
   for (auto m = &EV_TRUCKS[0]; *m != nullptr; m++) {
@@ -35,174 +26,190 @@ static bool isEV(const char *model) {
   return false;
 }
 
-// only parse the fields we need to save (lots of) memory
-//
-// ArduinoJson v6 filter:
-// {
-//   "game": {
-//     "connected": true,
-//     "paused": true
-//   },
-//   "truck": {
-//     "airPressureEmergencyOn": true,
-//     "airPressureWarningOn": true,
-//     "blinkerLeftActive": true,
-//     "blinkerRightActive": true,
-//     "cruiseControlOn": true,
-//     "cruiseControlSpeed": true,
-//     "electricOn": true,
-//     "fuel": true,
-//     "fuelAverageConsumption": true,
-//     "fuelCapacity": true,
-//     "fuelWarningOn": true,
-//     "lightsBeaconOn": true,
-//     "lightsBeamHighOn": true,
-//     "lightsBeamLowOn": true,
-//     "lightsBrakeOn": true,
-//     "lightsParkingOn": true,
-//     "model": true,
-//     "parkBrakeOn": true,
-//     "speed": true
-//   },
-//   "navigation": {
-//     "estimatedTime": true,
-//     "estimatedDistance": true,
-//     "speedLimit": true
-//   }
-// }
-static DeserializationOption::Filter &ets2TelemetryFilter() {
-  static StaticJsonDocument<JSON_FILTER_SIZE> f;
-  static auto filter = DeserializationOption::Filter(f);
-
-  if (f.isNull()) {
-    Serial.println("Initialize ETS2 JSON filter.");
-
-    auto g = f.createNestedObject("game");
-    g["connected"] = true;
-    g["paused"] = true;
-
-    auto t = f.createNestedObject("truck");
-    t["airPressureEmergencyOn"] = true;
-    t["airPressureWarningOn"] = true;
-    t["blinkerLeftActive"] = true;
-    t["blinkerRightActive"] = true;
-    t["cruiseControlOn"] = true;
-    t["cruiseControlSpeed"] = true;
-    t["electricOn"] = true;
-    t["fuel"] = true;
-    t["fuelAverageConsumption"] = true;
-    t["fuelCapacity"] = true;
-    t["fuelWarningOn"] = true;
-    t["lightsBeaconOn"] = true;
-    t["lightsBeamHighOn"] = true;
-    t["lightsBeamLowOn"] = true;
-    t["lightsBrakeOn"] = true;
-    t["lightsParkingOn"] = true;
-    t["model"] = true;
-    t["parkBrakeOn"] = true;
-    t["speed"] = true;
-
-    auto n = f.createNestedObject("navigation");
-    n["estimatedDistance"] = true;
-    n["estimatedTime"] = true;
-    n["speedLimit"] = true;
-  }
-  return filter;
-}
-
 Ets2Game::Ets2Game(TruckDashboard &dash, const char *api)
-  : Game(5 * TruckDashboard::FPS, 1000 / TruckDashboard::FPS), dash_(dash), api_(String(api)) {
-  http_.setReuse(true);
-}
-
-GameState Ets2Game::ets2TelemetryParse(String &json) {
-  StaticJsonDocument<JSON_DOC_SIZE> ets;
-  auto err = deserializeJson(ets, json, ets2TelemetryFilter());
-  if (err) {
-    Serial.printf("Parsing ETS2 JSON failed: %s\n", err.c_str());
-    return GameState::NOT_START;
+  : Game("ets2", 5 * TruckDashboard::FPS, 1000 / TruckDashboard::FPS, 1000 / TruckDashboard::FPS),
+    dash_(dash),
+    http_(api),
+    rate_(ETS2_POLL_FAST, ACTIVE_DELAY, ETS2_POLL_SLOW) {}
+
+static AdaptiveRate::Activity truckActivity(const TruckState &prev, const TruckState &curr, double accel) {
+  bool lights = (curr.leftBlinker != prev.leftBlinker) || (curr.rightBlinker != prev.rightBlinker)
+                || (curr.brake != prev.brake) || (curr.headlight != prev.headlight) || (curr.highBeam != prev.highBeam);
+  if (lights || accel >= DYNAMIC_ACCEL) {
+    return AdaptiveRate::Activity::DYNAMIC;
   }
+  if (curr.speed == 0 && (curr.parkBrake || !curr.on)) {
+    return AdaptiveRate::Activity::IDLE;  // parked
+  }
+  return AdaptiveRate::Activity::STEADY;
+}
 
-  JsonObject game = ets["game"];
-  if (game.isNull()) {
+GameState Ets2Game::ets2TelemetryParse(const Ets2Telemetry &ets) {
+  if (!ets.hasGame) {
     Serial.println("ETS2 JSON: no \"game\" object.");
     return GameState::NOT_START;
   }
-  if (!game["connected"]) {
+  if (!ets.connected) {
     Serial.println("ETS2 is not ready.");
     return GameState::NOT_START;
   }
-  if (CLOCK_ENABLE && game["paused"]) {
+  if (CLOCK_ENABLE && ets.paused) {
     DEBUG("ETS2 is paused.\n");
     return GameState::READY;
   }
 
   // never touch state_ until we can confirm we will success, so we can display
   // previous state on temporary failure.
-  JsonObject truck = ets["truck"];
-  if (!truck.isNull()) {
-    state_.isEV = isEV(truck["model"]);
-    state_.on = truck["electricOn"];
-    state_.speed = abs(round(KmConv((double)truck["speed"])));
-    state_.cruise = truck["cruiseControlOn"] ? round(KmConv(truck["cruiseControlSpeed"])) : 0;
+  TruckState state = state_;
+  double accel = 0;
+  if (ets.hasTruck) {
+    // per second, not per poll, as the polls speed up and slow down
+    unsigned long now = millis();
+    double speed = abs(KmConv(ets.speed));
+    if (sampleAt_ != 0) {
+      accel = abs(speed - speed_) * 1000 / max(now - sampleAt_, 1UL);
+    }
+    speed_ = speed;
+    sampleAt_ = now;
+
+    state.isEV = isEV(ets.model);
+    state.on = ets.electricOn;
+    state.speed = round(speed);
+    state.cruise = ets.cruiseOn ? round(KmConv(ets.cruiseSpeed)) : 0;
 
     // lights and warnings
-    state_.airEmerg = truck["airPressureEmergencyOn"];
-    state_.airWarn = truck["airPressureWarningOn"];
-    state_.beacon = truck["lightsBeaconOn"];
-    state_.brake = truck["lightsBrakeOn"];
-    state_.fuelWarn = truck["fuelWarningOn"];
-    state_.headlight = truck["lightsBeamLowOn"];
-    state_.highBeam = truck["lightsBeamHighOn"];
-    state_.leftBlinker = truck["blinkerLeftActive"];
-    state_.parkBrake = truck["parkBrakeOn"];
-    state_.parkingLight = truck["lightsParkingOn"];
-    state_.rightBlinker = truck["blinkerRightActive"];
+    state.airEmerg = ets.airEmerg;
+    state.airWarn = ets.airWarn;
+    state.beacon = ets.beacon;
+    state.brake = ets.brake;
+    state.fuelWarn = ets.fuelWarn;
+    state.headlight = ets.lowBeam;
+    state.highBeam = ets.highBeam;
+    state.leftBlinker = ets.leftBlinker;
+    state.parkBrake = ets.parkBrake;
+    state.parkingLight = ets.parkingLight;
+    state.rightBlinker = ets.rightBlinker;
 
     // set default fuel capacity on data error
-    double tank = truck["fuelCapacity"];
-    tank = (tank > DBL_EPSILON) ? tank : DEFAULT_TANK_SIZE;
-
-    double fuel = truck["fuel"];
-    state_.fuel = round(fuel * 100 / tank);
+    double tank = (ets.fuelCapacity > DBL_EPSILON) ? ets.fuelCapacity : DEFAULT_TANK_SIZE;
+    state.fuel = round(ets.fuel * 100 / tank);
 
-    double avg = truck["fuelAverageConsumption"];
-    if (avg > DBL_EPSILON) {
-      state_.fuelDist = round(KmConv(fuel / avg));
+    if (ets.fuelAvg > DBL_EPSILON) {
+      state.fuelDist = round(KmConv(ets.fuel / ets.fuelAvg));
     }  // else keep the previous value
   }
 
-  JsonObject nav = ets["navigation"];
-  if (!nav.isNull()) {
-    state_.etaDist = round(KmConv((double)nav["estimatedDistance"] / 1000));
-    state_.etaTime = toMinutes(nav["estimatedTime"]);
-    state_.limit = round(KmConv(nav["speedLimit"]));
+  if (ets.hasNav) {
+    state.etaDist = round(KmConv(ets.etaDist / 1000));
+    state.etaTime = max(ets.etaTime, 0);
+    state.limit = round(KmConv(ets.speedLimit));
   }
 
+  activity_ = truckActivity(state_, state, accel);
+  state_ = state;
   return GameState::DRIVING;
 }
 
-GameState Ets2Game::getTelemetry() {
-  GameState game = GameState::SERVER_DOWN;
+// feed the available body into the scanner, returns BUSY until finished
+GameState Ets2Game::ets2TelemetryRead() {
+  if (http_.code() != 200) {
+    Serial.printf("Invalid ETS2 response: %d!\n", http_.code());
+    return GameState::SERVER_DOWN;
+  }
 
-  http_.begin(client_, api_.c_str());
-#ifndef ESP8266
-  http_.setConnectTimeout(HTTP_CONN_TIMEOUT);
-#endif
-  http_.setTimeout(HTTP_READ_TIMEOUT);
+  auto &body = http_.body();
+  uint8_t buf[128];
+  int n;
+  while (scanner_.status() == Ets2Scanner::Status::SCANNING && (n = body.read(buf, sizeof(buf))) > 0) {
+    scanner_.feed(reinterpret_cast<const char *>(buf), n);
+  }
+
+  switch (scanner_.status()) {
+    case Ets2Scanner::Status::DONE:
+      return ets2TelemetryParse(ets_);
 
-  int http_code = http_.GET();
-  if (http_code == HTTP_CODE_OK) {
-    String json = http_.getString();
-    game = ets2TelemetryParse(json);
-  } else {
-    Serial.printf("Invalid ETS2 response: %d!\n", http_code);
+    case Ets2Scanner::Status::ERROR:
+      Serial.println("Parsing ETS2 JSON failed.");
+      return GameState::NOT_START;
+
+    default:
+      if (body.ended()) {
+        Serial.println("Parsing ETS2 JSON failed: incomplete input.");
+        return GameState::NOT_START;
+      }
+      return GameState::BUSY;
+  }
+}
+
+void Ets2Game::ingest() {
+  if (handoff_.pending()) {
+    return;  // wait for getTelemetry() to take it
+  }
+
+  if (http_.idle()) {
+    if (static_cast<long>(millis() - nextFetch_) >= 0) {
+      scanner_.begin(&ets_);
+      http_.get();
+    }
+    return;
+  }
+
+  http_.poll();
+  GameState result;
+  switch (http_.state()) {
+    case HttpFetch::State::READY:
+      result = ets2TelemetryRead();
+      if (result == GameState::BUSY) {
+        return;
+      }
+      break;
+
+    case HttpFetch::State::FAILED:
+      result = GameState::SERVER_DOWN;
+      break;
+
+    default:
+      return;  // still in flight
+  }
+
+  // the rest of the response is not needed
+  http_.reset();
+  handoff_.publish(result, state_);
+}
+
+unsigned long Ets2Game::ingestAt(unsigned long next) {
+  if (handoff_.pending()) {
+    return next;  // nothing to do until getTelemetry()
+  }
+  if (http_.idle()) {
+    return earliest(next, nextFetch_);
+  }
+  return millis();  // request in flight, keep polling
+}
+
+// fetch just before the next probe, instead of a stale result waiting for it
+void Ets2Game::probeAt(unsigned long at) {
+  nextFetch_ = at - FETCH_LEAD;
+  ingestWake();
+}
+
+GameState Ets2Game::getTelemetry() {
+  GameState result;
+  if (!handoff_.take(result)) {
+    return GameState::BUSY;
   }
-  http_.end();
 
-  return game;
+  if (result == GameState::DRIVING) {
+    rate_.sample(activity_, http_.rtt());
+  } else if (result == GameState::READY) {
+    rate_.sample(AdaptiveRate::Activity::IDLE, http_.rtt());  // paused, no hurry
+  }  // keep the rate on failures, not to delay the failure detection
+  unsigned long delay = rate_.delay();
+  nextFetch_ = millis() + delay - min(FETCH_LEAD, delay / 2);
+  ingestWake();  // to fetch at the new time
+  return result;
 }
 
 void Ets2Game::freshDisplay(time_t time) {
-  dash_.fresh(this, time, &state_);
+  dash_.fresh(this, time, handoff_.state(), stale_);
 }
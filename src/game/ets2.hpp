@@ -11,30 +11,50 @@
 #include "../dashboard/truck.hpp"
 
 #include <Arduino.h>
-#ifdef ESP8266
-#include <ESP8266HTTPClient.h>
-#else
-#include <HTTPClient.h>
-#endif
+#include "ets2_scanner.hpp"
+#include "../net/http_fetch.hpp"
+#include "../sched/adaptive_rate.hpp"
 
-class Ets2Game : public Game {
+class Ets2Game final : public Game {
 public:
   Ets2Game(TruckDashboard &dash, const char *api);
   GameState getTelemetry() override;
   void freshDisplay(time_t time) override;
+  void probeAt(unsigned long at) override;
+
+  inline unsigned long pollDelay() const override {
+    return rate_.delay();
+  }
+
+  inline void stop() override {
+    http_.stop();
+  }
 
   inline const char *name() const override {
     return "ETS2";
   }
 
+protected:
+  void ingest() override;
+  unsigned long ingestAt(unsigned long next) override;
+
 private:
-  GameState ets2TelemetryParse(String &json);
+  GameState ets2TelemetryRead();
+  GameState ets2TelemetryParse(const Ets2Telemetry &ets);
 
 private:
   TruckDashboard &dash_;
-  String api_;
+  TelemetryHandoff<TruckState> handoff_;
+
+  // ingest side
+  HttpFetch http_;
+  unsigned long nextFetch_{};  // when to start the next request
+  Ets2Scanner scanner_{};
+  Ets2Telemetry ets_{};
+  AdaptiveRate rate_;
+  AdaptiveRate::Activity activity_{};  // of the last result
+  double speed_{};                     // km/h, unrounded
+  unsigned long sampleAt_{};           // of speed_
 
-  HTTPClient http_{};
-  WiFiClient client_{};
   TruckState state_{};
 };
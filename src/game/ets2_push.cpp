@@ -0,0 +1,104 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "ets2_push.hpp"
+#include "../utils.hpp"
+
+Ets2PushGame::Ets2PushGame(TruckDashboard &dash, uint16_t port)
+  : Game("ets2push", 5 * TruckDashboard::FPS, 1000 / TruckDashboard::FPS, 1000 / TruckDashboard::FPS), dash_(dash), udp_(port, IsEts2PushPacket) {}
+
+// returns false if the packet is invalid
+bool Ets2PushGame::ets2PushRead(int len) {
+  // the trailing fields of newer versions are cut by the queue
+  Ets2PushHeader hdr;
+  if (!Ets2PushDecode(pkt_, len, push_, hdr)) {
+    Serial.printf("Invalid %s packet of size %d\n", name(), len);
+    return false;
+  }
+
+  uint16_t gap = hdr.seq - seq_ - 1;
+  seq_ = hdr.seq;
+  if (hdr.flags & PUSH_KEYFRAME) {
+    synced_ = true;
+  } else if (gap != 0 && synced_) {
+    // some fields could be stale, until the next keyframe
+    DEBUG("%s lost %u packets\n", name(), gap);
+    lost_ += gap;
+    synced_ = false;
+  }
+  return true;
+}
+
+GameState Ets2PushGame::ets2PushParse() {
+  const int16_t *v = push_.values;
+  switch (v[PUSH_STATE]) {
+    case PUSH_RUNNING:
+      break;
+
+    case PUSH_PAUSED:
+      if (CLOCK_ENABLE) {
+        return GameState::READY;
+      }
+      break;
+
+    default:
+      return GameState::NOT_START;
+  }
+
+  uint16_t lights = v[PUSH_LIGHTS];
+  state_ = {
+    .isEV = (lights & LIGHT_EV) != 0,
+    .on = (lights & LIGHT_ELECTRIC) != 0,
+    .headlight = (lights & LIGHT_LOW_BEAM) != 0,
+    .parkingLight = (lights & LIGHT_PARKING) != 0,
+    .highBeam = (lights & LIGHT_HIGH_BEAM) != 0,
+    .leftBlinker = (lights & LIGHT_LBLINKER) != 0,
+    .rightBlinker = (lights & LIGHT_RBLINKER) != 0,
+    .beacon = (lights & LIGHT_BEACON) != 0,
+    .brake = (lights & LIGHT_BRAKE) != 0,
+    .parkBrake = (lights & LIGHT_PARK_BRAKE) != 0,
+    .airWarn = (lights & LIGHT_AIR_WARN) != 0,
+    .airEmerg = (lights & LIGHT_AIR_EMERG) != 0,
+
+    .fuelWarn = (lights & LIGHT_FUEL_WARN) != 0,
+    .fuelDist = static_cast<int>(round(KmConv(v[PUSH_FUEL_DIST]))),
+    .fuel = v[PUSH_FUEL],
+    .cruise = static_cast<int>(round(KmConv(v[PUSH_CRUISE]))),
+    .speed = static_cast<int>(round(KmConv(v[PUSH_SPEED]))),
+
+    .etaDist = static_cast<int>(round(KmConv(v[PUSH_ETA_DIST]))),
+    .etaTime = v[PUSH_ETA_TIME],
+    .limit = static_cast<int>(round(KmConv(v[PUSH_LIMIT]))),
+  };
+  return GameState::DRIVING;
+}
+
+void Ets2PushGame::ingest() {
+  // apply all the queued deltas, in order
+  bool received = false;
+  int len;
+  while ((len = udp_.pop(pkt_, sizeof(pkt_))) > 0) {
+    received |= ets2PushRead(len);
+  }
+
+  if (received) {
+    GameState result = synced_ ? ets2PushParse() : GameState::BUSY;  // wait for the keyframe
+    handoff_.publish(result, state_);
+  }
+}
+
+GameState Ets2PushGame::getTelemetry() {
+  GameState result;
+  if (!handoff_.take(result)) {
+    return GameState::SERVER_DOWN;  // no packet
+  }
+  return result;
+}
+
+void Ets2PushGame::freshDisplay(time_t time) {
+  dash_.fresh(this, time, handoff_.state(), stale_);
+}
@@ -0,0 +1,70 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+#include "ets2_udp.hpp"
+#include "game.hpp"
+#include "../dashboard/truck.hpp"
+#include "../net/udp_mux.hpp"
+
+// ETS2 telemetry pushed by tools/ets2_bridge, instead of polling the server.
+class Ets2PushGame final : public Game {
+public:
+  Ets2PushGame(TruckDashboard &dash, uint16_t port);
+  GameState getTelemetry() override;
+  void freshDisplay(time_t time) override;
+
+  inline const char *name() const override {
+    return "ETS2 Push";
+  }
+
+  inline void start() override {
+    Serial.printf("Listening %s telemetry on: %u\n", name(), udp_.port());
+    synced_ = false;
+    udp_.begin();
+  }
+
+  inline void stop() override {
+    udp_.end();
+  }
+
+  inline bool arrived() override {
+    return udp_.arrived();
+  }
+
+  inline bool published() override {
+    return handoff_.published();
+  }
+
+  // packets lost in the sequence
+  inline uint32_t lost() const {
+    return lost_;
+  }
+
+protected:
+  void ingest() override;
+
+private:
+  bool ets2PushRead(int len);
+  GameState ets2PushParse();
+
+private:
+  TruckDashboard &dash_;
+  TelemetryHandoff<TruckState> handoff_;
+
+  // ingest side
+  TruckState state_{};
+  // deep enough for the pushes between two frames, every delta matters
+  UdpQueueOf<ETS2_PUSH_MAX_SIZE, 16> udp_;
+  uint8_t pkt_[ETS2_PUSH_MAX_SIZE]{};  // packet buffer, the unknown fields are dropped
+  Ets2PushState push_{};
+  uint16_t seq_{};    // of the last packet
+  bool synced_{};     // push_ is complete since the last keyframe
+  uint32_t lost_{};
+};
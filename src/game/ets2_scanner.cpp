@@ -0,0 +1,334 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "ets2_scanner.hpp"
+#include <cstdlib>
+#include <cstring>
+
+// The fields we need, by "section.key" path
+#define ETS2_FIELDS(X) \
+  X(GAME_CONNECTED, "game.connected") \
+  X(GAME_PAUSED, "game.paused") \
+  X(TRUCK_AIR_EMERG, "truck.airPressureEmergencyOn") \
+  X(TRUCK_AIR_WARN, "truck.airPressureWarningOn") \
+  X(TRUCK_LEFT_BLINKER, "truck.blinkerLeftActive") \
+  X(TRUCK_RIGHT_BLINKER, "truck.blinkerRightActive") \
+  X(TRUCK_CRUISE_ON, "truck.cruiseControlOn") \
+  X(TRUCK_CRUISE_SPEED, "truck.cruiseControlSpeed") \
+  X(TRUCK_ELECTRIC_ON, "truck.electricOn") \
+  X(TRUCK_FUEL, "truck.fuel") \
+  X(TRUCK_FUEL_AVG, "truck.fuelAverageConsumption") \
+  X(TRUCK_FUEL_CAPACITY, "truck.fuelCapacity") \
+  X(TRUCK_FUEL_WARN, "truck.fuelWarningOn") \
+  X(TRUCK_BEACON, "truck.lightsBeaconOn") \
+  X(TRUCK_HIGH_BEAM, "truck.lightsBeamHighOn") \
+  X(TRUCK_LOW_BEAM, "truck.lightsBeamLowOn") \
+  X(TRUCK_BRAKE, "truck.lightsBrakeOn") \
+  X(TRUCK_PARKING_LIGHT, "truck.lightsParkingOn") \
+  X(TRUCK_MODEL, "truck.model") \
+  X(TRUCK_PARK_BRAKE, "truck.parkBrakeOn") \
+  X(TRUCK_SPEED, "truck.speed") \
+  X(NAV_ETA_DIST, "navigation.estimatedDistance") \
+  X(NAV_ETA_TIME, "navigation.estimatedTime") \
+  X(NAV_SPEED_LIMIT, "navigation.speedLimit")
+
+#define AS_ENUM(id, path) id,
+enum Ets2Field { ETS2_FIELDS(AS_ENUM) FIELD_MAX };
+#undef AS_ENUM
+
+static_assert(FIELD_MAX <= 32, "Too many fields for the bitmap");
+static constexpr uint32_t ALL_FIELDS = (FIELD_MAX == 32) ? ~0u : ((1u << FIELD_MAX) - 1);
+
+// FNV-1a, evaluated at compile time for the case labels below
+static constexpr uint32_t fnv1a(const char *s, uint32_t h = 2166136261u) {
+  return (*s == '\0') ? h : fnv1a(s + 1, (h ^ static_cast<uint8_t>(*s)) * 16777619u);
+}
+
+// Map the path to field with a switch on the hash. Any hash collision in the
+// key set is a duplicated case value, which fails the build. The final strcmp
+// rejects the unknown keys which happen to share a hash with ours.
+static int fieldOf(const char *path) {
+#define AS_CASE(id, p) \
+  case fnv1a(p): \
+    return (strcmp(path, p) == 0) ? id : -1;
+
+  switch (fnv1a(path)) {
+    ETS2_FIELDS(AS_CASE)
+    default:
+      return -1;
+  }
+#undef AS_CASE
+}
+
+static inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline bool toBool(const char *val) {
+  return strcmp(val, "true") == 0;
+}
+
+static inline int toDigits(const char *s, int n) {
+  int val = 0;
+  for (int i = 0; i < n; i++) {
+    if (s[i] < '0' || s[i] > '9') {
+      return -1;
+    }
+    val = val * 10 + (s[i] - '0');
+  }
+  return val;
+}
+
+int Ets2Scanner::toMinutes(const char *date) {
+  // days before each month, the ETA is counted from year 0001 (not leap)
+  static constexpr int MONTH_DAYS[]{ 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+  // 0123456789012345678
+  // 0001-01-05T05:11:00Z
+  if (strlen(date) < 19 || date[4] != '-' || date[7] != '-' || date[10] != 'T' || date[13] != ':' || date[16] != ':') {
+    return -1;
+  }
+
+  int mon = toDigits(date + 5, 2), day = toDigits(date + 8, 2),
+      h = toDigits(date + 11, 2), m = toDigits(date + 14, 2), s = toDigits(date + 17, 2);
+  if (mon < 1 || mon > 12 || day < 1 || h < 0 || m < 0 || s < 0) {
+    return -1;
+  }
+
+  int yday = MONTH_DAYS[mon - 1] + day - 1;
+  return (yday * 24 + h) * 60 + m + (s < 30 ? 0 : 1);
+}
+
+void Ets2Scanner::begin(Ets2Telemetry *out) {
+  *out = {};
+  out_ = out;
+  status_ = Status::SCANNING;
+  seen_ = 0;
+
+  mode_ = Mode::STRUCT;
+  escape_ = false;
+  isKey_ = false;
+  expectKey_ = false;
+  depth_ = 0;
+  arrays_ = 0;
+  sectionLen_ = 0;
+  keyValid_ = false;
+  tokenLen_ = 0;
+  truncated_ = false;
+}
+
+Ets2Scanner::Status Ets2Scanner::feed(const char *data, size_t len) {
+  for (size_t i = 0; i < len && status_ == Status::SCANNING; i++) {
+    if (!scan(data[i])) {
+      status_ = Status::ERROR;
+    }
+  }
+  return status_;
+}
+
+void Ets2Scanner::openContainer(bool isArray) {
+  if (depth_ == 1) {
+    // entering a section, only objects are interested
+    sectionLen_ = 0;
+    if (!isArray && keyValid_) {
+      sectionLen_ = strlen(path_) + 1;
+      if (sectionLen_ < PATH_SIZE) {
+        path_[sectionLen_ - 1] = '.';
+        path_[sectionLen_] = '\0';
+      } else {
+        sectionLen_ = 0;
+      }
+    }
+  }
+
+  depth_++;
+  if (isArray) {
+    arrays_ |= (1u << depth_);
+  } else {
+    arrays_ &= ~(1u << depth_);
+  }
+  expectKey_ = !isArray;
+  keyValid_ = false;
+}
+
+void Ets2Scanner::closeContainer() {
+  depth_--;
+  expectKey_ = false;
+  keyValid_ = false;
+  if (depth_ <= 1) {
+    sectionLen_ = 0;
+  }
+  if (depth_ == 0) {
+    status_ = Status::DONE;  // end of JSON
+  }
+}
+
+void Ets2Scanner::onKey() {
+  keyValid_ = !truncated_;
+  if (depth_ == 1) {
+    memcpy(path_, token_, tokenLen_ + 1);
+  } else if (depth_ == 2 && sectionLen_ > 0) {
+    if (sectionLen_ + tokenLen_ < PATH_SIZE) {
+      memcpy(path_ + sectionLen_, token_, tokenLen_ + 1);
+    } else {
+      keyValid_ = false;
+    }
+  }
+}
+
+void Ets2Scanner::onValue(bool isString) {
+  if (depth_ != 2 || sectionLen_ == 0 || !keyValid_) {
+    return;
+  }
+  keyValid_ = false;
+
+  int field = fieldOf(path_);
+  if (field < 0) {
+    return;
+  }
+
+  auto *t = out_;
+  const char *val = token_;
+  double num = isString ? 0 : strtod(val, nullptr);
+
+  switch (field) {
+    case GAME_CONNECTED: t->connected = toBool(val); break;
+    case GAME_PAUSED: t->paused = toBool(val); break;
+
+    case TRUCK_AIR_EMERG: t->airEmerg = toBool(val); break;
+    case TRUCK_AIR_WARN: t->airWarn = toBool(val); break;
+    case TRUCK_LEFT_BLINKER: t->leftBlinker = toBool(val); break;
+    case TRUCK_RIGHT_BLINKER: t->rightBlinker = toBool(val); break;
+    case TRUCK_CRUISE_ON: t->cruiseOn = toBool(val); break;
+    case TRUCK_CRUISE_SPEED: t->cruiseSpeed = num; break;
+    case TRUCK_ELECTRIC_ON: t->electricOn = toBool(val); break;
+    case TRUCK_FUEL: t->fuel = num; break;
+    case TRUCK_FUEL_AVG: t->fuelAvg = num; break;
+    case TRUCK_FUEL_CAPACITY: t->fuelCapacity = num; break;
+    case TRUCK_FUEL_WARN: t->fuelWarn = toBool(val); break;
+    case TRUCK_BEACON: t->beacon = toBool(val); break;
+    case TRUCK_HIGH_BEAM: t->highBeam = toBool(val); break;
+    case TRUCK_LOW_BEAM: t->lowBeam = toBool(val); break;
+    case TRUCK_BRAKE: t->brake = toBool(val); break;
+    case TRUCK_PARKING_LIGHT: t->parkingLight = toBool(val); break;
+    case TRUCK_MODEL:
+      strncpy(t->model, val, sizeof(t->model) - 1);
+      t->model[sizeof(t->model) - 1] = '\0';
+      break;
+    case TRUCK_PARK_BRAKE: t->parkBrake = toBool(val); break;
+    case TRUCK_SPEED: t->speed = num; break;
+
+    case NAV_ETA_DIST: t->etaDist = num; break;
+    case NAV_ETA_TIME: t->etaTime = isString ? toMinutes(val) : 0; break;
+    case NAV_SPEED_LIMIT: t->speedLimit = num; break;
+
+    default: break;
+  }
+
+  if (field <= GAME_PAUSED) {
+    t->hasGame = true;
+  } else if (field <= TRUCK_SPEED) {
+    t->hasTruck = true;
+  } else {
+    t->hasNav = true;
+  }
+
+  seen_ |= (1u << field);
+  if (seen_ == ALL_FIELDS) {
+    status_ = Status::DONE;  // no need to read the rest
+  }
+}
+
+// returns false on syntax error
+bool Ets2Scanner::scan(char c) {
+  switch (mode_) {
+    case Mode::STRING:
+      if (escape_) {
+        escape_ = false;  // keep the escaped char as is, none of our fields need it
+      } else if (c == '\\') {
+        escape_ = true;
+        return true;
+      } else if (c == '"') {
+        token_[tokenLen_] = '\0';
+        mode_ = Mode::STRUCT;
+        if (isKey_) {
+          onKey();
+        } else {
+          onValue(true);
+        }
+        return true;
+      }
+      if (tokenLen_ < TOKEN_SIZE - 1) {
+        token_[tokenLen_++] = c;
+      } else {
+        truncated_ = true;
+      }
+      return true;
+
+    case Mode::BARE:
+      if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '.' || c == '-' || c == '+' || c == 'E') {
+        if (tokenLen_ < TOKEN_SIZE - 1) {
+          token_[tokenLen_++] = c;
+        }
+        return true;
+      }
+      token_[tokenLen_] = '\0';
+      mode_ = Mode::STRUCT;
+      onValue(false);
+      break;  // the terminator is a structural char
+
+    default:
+      break;
+  }
+
+  if (isSpace(c)) {
+    return true;
+  }
+
+  bool inObject = (depth_ > 0) && !(arrays_ & (1u << depth_));
+  switch (c) {
+    case '{':
+    case '[':
+      if (depth_ >= MAX_DEPTH - 1) {
+        return false;
+      }
+      openContainer(c == '[');
+      return true;
+
+    case '}':
+    case ']':
+      if (depth_ == 0 || (c == '}') != inObject) {
+        return false;
+      }
+      closeContainer();
+      return true;
+
+    case ',':
+      expectKey_ = inObject;
+      return true;
+
+    case ':':
+      return inObject;
+
+    case '"':
+      mode_ = Mode::STRING;
+      isKey_ = expectKey_ && inObject;
+      expectKey_ = false;
+      tokenLen_ = 0;
+      truncated_ = false;
+      return true;
+
+    default:
+      if (depth_ == 0) {
+        return false;
+      }
+      mode_ = Mode::BARE;
+      token_[0] = c;
+      tokenLen_ = 1;
+      return true;
+  }
+}
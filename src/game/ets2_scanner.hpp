@@ -0,0 +1,111 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Incremental scanner for the ETS2 Telemetry Web Server JSON. Only the fields
+// we need are picked up, everything else is skipped without being stored. The
+// input could be fed in chunks of any size as it arrives from the socket.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct Ets2Telemetry {
+  // which objects are present
+  bool hasGame;
+  bool hasTruck;
+  bool hasNav;
+
+  // game
+  bool connected;
+  bool paused;
+
+  // truck
+  char model[24];
+  bool electricOn;
+  bool cruiseOn;
+  bool airEmerg;
+  bool airWarn;
+  bool beacon;
+  bool brake;
+  bool fuelWarn;
+  bool lowBeam;
+  bool highBeam;
+  bool leftBlinker;
+  bool rightBlinker;
+  bool parkBrake;
+  bool parkingLight;
+  double speed;
+  double cruiseSpeed;
+  double fuel;
+  double fuelAvg;
+  double fuelCapacity;
+
+  // navigation
+  double etaDist;  // meters
+  int etaTime;     // minutes
+  double speedLimit;
+};
+
+class Ets2Scanner {
+public:
+  enum class Status {
+    SCANNING,
+    DONE,  // all fields found, or the end of JSON
+    ERROR,
+  };
+
+  void begin(Ets2Telemetry *out);
+  Status feed(const char *data, size_t len);
+
+  inline Status status() const {
+    return status_;
+  }
+
+  // ISO8601: "0001-01-05T05:11:00Z", returns -1 on error
+  static int toMinutes(const char *date);
+
+private:
+  enum class Mode : uint8_t {
+    STRUCT,  // between tokens
+    STRING,
+    BARE,  // number, true, false, null
+  };
+
+  bool scan(char c);
+  void openContainer(bool isArray);
+  void closeContainer();
+  void onKey();
+  void onValue(bool isString);
+
+private:
+  static constexpr size_t PATH_SIZE = 48;
+  static constexpr size_t TOKEN_SIZE = 32;  // longer tokens are truncated
+  static constexpr int MAX_DEPTH = 32;
+
+  Ets2Telemetry *out_{};
+  Status status_{ Status::DONE };
+  uint32_t seen_{};  // bitmap of the fields found
+
+  Mode mode_{ Mode::STRUCT };
+  bool escape_{};
+  bool isKey_{};
+  bool expectKey_{};
+
+  int depth_{};
+  uint32_t arrays_{};  // bitmap of the containers which are arrays
+
+  char path_[PATH_SIZE]{};  // "section.key" of the current field
+  size_t sectionLen_{};     // length of "section.", 0 for no section
+  bool keyValid_{};
+
+  char token_[TOKEN_SIZE]{};
+  size_t tokenLen_{};
+  bool truncated_{};
+};
@@ -0,0 +1,129 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// ETS2 push protocol, sent by tools/ets2_bridge running on the gaming PC.
+//
+// Packet: header + int16 values of the fields set in the header bitmap, in
+// field order. Only the changed fields are sent, plus periodic keyframes with
+// all the fields to recover from packet loss. New fields are only appended
+// with a new version, so older receivers accept the newer packets and just
+// ignore the trailing fields they don't know.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+constexpr uint16_t ETS2_PUSH_PORT = 25556;  // next to the telemetry server
+
+constexpr uint32_t ETS2_PUSH_MAGIC = 0x50325445;  // "ET2P"
+constexpr uint8_t ETS2_PUSH_VERSION = 1;
+
+enum Ets2PushFlag : uint8_t {
+  PUSH_KEYFRAME = 0x01,  // all fields included
+};
+
+enum Ets2PushField {
+  PUSH_STATE,      // Ets2PushGameState
+  PUSH_LIGHTS,     // Ets2PushLight bitmap
+  PUSH_SPEED,      // km/h
+  PUSH_CRUISE,     // km/h, 0 for off
+  PUSH_LIMIT,      // km/h, 0 for no limit
+  PUSH_FUEL,       // percentage
+  PUSH_FUEL_DIST,  // km
+  PUSH_ETA_DIST,   // km
+  PUSH_ETA_TIME,   // minutes
+  PUSH_FIELD_MAX,
+};
+static_assert(PUSH_FIELD_MAX <= 16, "Too many fields for the bitmap");
+
+enum Ets2PushGameState : int16_t {
+  PUSH_NOT_RUNNING,  // game not started or the telemetry server is down
+  PUSH_PAUSED,
+  PUSH_RUNNING,
+};
+
+enum Ets2PushLight : uint16_t {
+  LIGHT_ELECTRIC = 1 << 0,
+  LIGHT_EV = 1 << 1,  // electric truck
+  LIGHT_LOW_BEAM = 1 << 2,
+  LIGHT_PARKING = 1 << 3,
+  LIGHT_HIGH_BEAM = 1 << 4,
+  LIGHT_LBLINKER = 1 << 5,
+  LIGHT_RBLINKER = 1 << 6,
+  LIGHT_BEACON = 1 << 7,
+  LIGHT_BRAKE = 1 << 8,
+  LIGHT_PARK_BRAKE = 1 << 9,
+  LIGHT_AIR_WARN = 1 << 10,
+  LIGHT_AIR_EMERG = 1 << 11,
+  LIGHT_FUEL_WARN = 1 << 12,
+};
+
+struct __attribute__((packed)) Ets2PushHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t flags;    // Ets2PushFlag
+  uint16_t seq;     // increased on every packet
+  uint16_t fields;  // bitmap of the fields followed
+};
+
+struct Ets2PushState {
+  int16_t values[PUSH_FIELD_MAX];
+};
+
+constexpr size_t ETS2_PUSH_MAX_SIZE = sizeof(Ets2PushHeader) + sizeof(int16_t) * PUSH_FIELD_MAX;
+
+// Encode the fields changed from prev (all the fields if prev is nullptr) into
+// buf of at least ETS2_PUSH_MAX_SIZE, returns the packet size.
+inline size_t Ets2PushEncode(uint8_t *buf, uint16_t seq, const Ets2PushState &curr, const Ets2PushState *prev) {
+  Ets2PushHeader hdr{ ETS2_PUSH_MAGIC, ETS2_PUSH_VERSION, uint8_t(prev ? 0 : PUSH_KEYFRAME), seq, 0 };
+  size_t len = sizeof(hdr);
+
+  for (int i = 0; i < PUSH_FIELD_MAX; i++) {
+    if (prev == nullptr || curr.values[i] != prev->values[i]) {
+      hdr.fields |= (1 << i);
+      memcpy(buf + len, &curr.values[i], sizeof(int16_t));
+      len += sizeof(int16_t);
+    }
+  }
+  memcpy(buf, &hdr, sizeof(hdr));
+  return len;
+}
+
+// Apply the fields in the packet to state, which is untouched on invalid packet.
+inline bool Ets2PushDecode(const uint8_t *buf, size_t len, Ets2PushState &state, Ets2PushHeader &hdr) {
+  if (len < sizeof(hdr)) {
+    return false;
+  }
+  memcpy(&hdr, buf, sizeof(hdr));
+  if (hdr.magic != ETS2_PUSH_MAGIC || hdr.version < ETS2_PUSH_VERSION) {
+    return false;
+  }
+
+  // fields unknown to this version are appended, their bits and values are
+  // left behind unread
+  Ets2PushState next = state;
+  size_t pos = sizeof(hdr);
+  for (int i = 0; i < PUSH_FIELD_MAX; i++) {
+    if (hdr.fields & (1 << i)) {
+      if (pos + sizeof(int16_t) > len) {
+        return false;  // truncated
+      }
+      memcpy(&next.values[i], buf + pos, sizeof(int16_t));
+      pos += sizeof(int16_t);
+    }
+  }
+  state = next;
+  return true;
+}
+
+static inline bool IsEts2PushPacket(size_t len) {
+  return len >= sizeof(Ets2PushHeader) && len <= 256;
+}
@@ -9,7 +9,10 @@
 #include "../utils.hpp"
 
 ForzaGame::ForzaGame(RacingDashboard &dash, uint16_t port)
-  : Game(5 * RacingDashboard::FPS, 1000 / RacingDashboard::FPS), dash_(dash), port_(port) {}
+  : Game("forza", 5 * RacingDashboard::FPS, 1000 / RacingDashboard::FPS, 1000 / RacingDashboard::FPS),
+    dash_(dash),
+    udp_(port, IsForzaPacket, UdpQueue::Read::LATEST),
+    rate_(ACTIVE_DELAY, ACTIVE_DELAY, RACING_POLL_SLOW) {}
 
 GameState ForzaGame::forzaTelemetryParse(size_t len) {
   const ForzaSledData *sled{};
@@ -46,6 +49,7 @@ GameState ForzaGame::forzaTelemetryParse(size_t len) {
     .gear = dash->Gear,
     .rpmIdle = static_cast<int>(round(sled->EngineIdleRpm)),
     .rpm = static_cast<int>(round(sled->CurrentEngineRpm)),
+    .rpmPeak = static_cast<int>(round(rpmPeak_)),
     .rpmMax = static_cast<int>(round(sled->EngineMaxRpm)),
     .fuel = static_cast<int>(dash->Fuel * 100.0),
     .isPro = sled->CarClass >= FORZA_PRO_CLASS,
@@ -59,26 +63,34 @@ GameState ForzaGame::forzaTelemetryParse(size_t len) {
   return GameState::DRIVING;
 }
 
-GameState ForzaGame::getTelemetry() {
-  int len = udp_.parsePacket();
+void ForzaGame::ingest() {
+  // decode the newest packet only, but never miss the rpm peak for shift lights
+  unsigned long now = millis();
+  int len = udp_.popLatest(pkt_.bytes, sizeof(pkt_), [this, now](int) {
+    float rpm = pkt_.motosportV1.sled.CurrentEngineRpm;  // sled leads all versions
+    if (rpm >= rpmPeak_ || now - peakAt_ >= static_cast<unsigned long>(FRAME_DELAY)) {
+      rpmPeak_ = rpm;
+      peakAt_ = now;
+    }
+  });
   if (len <= 0) {
-    return GameState::SERVER_DOWN;  // no packet
-  }
-
-  if (!IsForzaPacket(len)) {
-    Serial.printf("Invalid %s packet of size %d from %s\n", name(), len, udp_.remoteIP().toString().c_str());
-    return GameState::SERVER_DOWN;
+    return;
   }
+  LAZY_EXEC(false, udp_.dropped(), dropped_,
+            DEBUG("%s packets dropped: %u, coalesced: %u\n", name(), udp_.dropped(), udp_.coalesced()));
+  GameState result = forzaTelemetryParse(len);
+  rate_.sample((result == GameState::READY) ? AdaptiveRate::Activity::IDLE : AdaptiveRate::Activity::STEADY);
+  handoff_.publish(result, state_);
+}
 
-  int n = udp_.read(pkt_.bytes, sizeof(pkt_));
-  if (n != len) {
-    Serial.printf("Failed to read %s packet: %d of %d\n", name(), n, len);
-    return GameState::SERVER_DOWN;
+GameState ForzaGame::getTelemetry() {
+  GameState result;
+  if (!handoff_.take(result)) {
+    return GameState::SERVER_DOWN;  // no packet
   }
-
-  return forzaTelemetryParse(n);
+  return result;
 }
 
 void ForzaGame::freshDisplay([[maybe_unused]] time_t time) {
-  dash_.fresh(this, &state_);
+  dash_.fresh(this, handoff_.state(), stale_);
 }
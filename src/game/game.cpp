@@ -7,24 +7,61 @@
 
 #include "game.hpp"
 #include "../utils.hpp"
+#include "../sched/idle.hpp"
 
-static constexpr int IDLE_DELAY = 5000;  // API query interval when idle
+static constexpr int IDLE_DELAY = 5000;       // API query interval when idle
+static constexpr unsigned long MAX_PROBE_DELAY = 30000;  // backoff limit of unreachable servers
+static constexpr unsigned long CHEAP_PROBE = 1000;       // us, probes not worth a backoff
+static constexpr int LED_DELAY = 1000 / 60;   // RGB LED refresh interval
+static constexpr int REPORT_DELAY = 60000;    // statistics interval
+static constexpr int STALE_POLLS = 3;         // polls missed to mark the data stale
+static constexpr int OFFLINE_GRACE = 30000;   // keep the game while the network is down
+static constexpr unsigned long HOUR = 3600000;           // window of the mode switch counter
 
-Controller *Controller::instance_ = nullptr;
-
-Controller::Controller(NtpClock &clock, Game **games, size_t count)
-  : clock_(clock), timer_(SoftwareTimer(IDLE_DELAY, timerCb)), games_(games), gameCount_(count) {
-  instance_ = this;
+// apart from the frames, the cost is taken by the next probe
+void Game::IngestTask::run() {
+  TASK_BEGIN();
+  while (true) {
+    {
+      unsigned long start = micros();
+      game_.ingest();
+      game_.probe_.spentUs += micros() - start;
+    }
+    TASK_SLEEP(game_.ingestAt(now_ + IDLE_POLL) - now_);
+  }
+  TASK_END();
 }
 
-void Controller::updateState() {
+ControllerBase::ControllerBase(Display &disp, NtpClock &clock, Game *const *games, size_t count)
+  : disp_(disp),
+    clock_(clock),
+    poll_(IDLE_DELAY),
+    render_(IDLE_DELAY),
+    leds_(LED_DELAY),
+    report_(REPORT_DELAY),
+    games_(games),
+    gameCount_(count) {}
+
+// Switch between the dashboard and the clock with hysteresis: a pause must
+// hold for a while to leave the dashboard, and each mode is kept for a
+// minimum dwell time, except that an inactive game leaves at once (it has
+// been through the grace period already).
+void ControllerBase::updateState() {
+  unsigned long now = millis();
+  bool driving = driving_;
+
   if (active_ != nullptr) {
     switch (state_) {
       case GameState::DRIVING:
-        driving_ = true;
+        paused_ = false;
+        driving = true;
         break;
       case GameState::READY:  // game paused, quit driving mode
-        driving_ = false;
+        if (!paused_) {
+          paused_ = true;
+          pausedAt_ = now;
+        }
+        driving = (now - pausedAt_ < static_cast<unsigned long>(MODE_PAUSE_HOLD)) && driving_;
         break;
       default:
         // for temporary failure, preserve the last mode
@@ -32,20 +69,65 @@ void Controller::updateState() {
         break;
     }
   } else {
-    driving_ = false;  // inactive
+    paused_ = false;
+    driving = false;  // inactive
+  }
+
+  if (driving == driving_) {
+    return;
+  }
+  unsigned long dwell = driving_ ? MODE_DASH_DWELL : MODE_CLOCK_DWELL;
+  if (active_ != nullptr && now - modeAt_ < dwell) {
+    return;  // check again on the next poll
+  }
+  switchMode(driving, now);
+}
+
+void ControllerBase::switchMode(bool driving, unsigned long now) {
+  driving_ = driving;
+  modeAt_ = now;
+
+  switches_++;
+  rollHour(now);
+  hourSwitches_++;
+  DEBUG("Switch to %s mode\n", driving ? "dashboard" : "clock");
+}
+
+// start a new hour of the switch counter
+void ControllerBase::rollHour(unsigned long now) {
+  if (now - hourAt_ < HOUR) {
+    return;
   }
+  lastHourSwitches_ = (now - hourAt_ < 2 * HOUR) ? hourSwitches_ : 0;
+  hourSwitches_ = 0;
+  hourAt_ += (now - hourAt_) / HOUR * HOUR;
 }
 
-bool Controller::pollGame(Game &game) {
-  state_ = game.getTelemetry();
+// the telemetry taken into state_, true if still in this game
+bool ControllerBase::pollResult(Game &game, const char *name, unsigned long pollDelay) {
+  if (state_ == GameState::BUSY) {
+    return active_ == &game;  // no news yet, keep the current mode
+  }
   if (state_ >= GameState::READY) {
     if (active_ != &game) {
       // the game become active, speed up polling for faster responses
-      Serial.printf("%s become active.\n", game.name());
+      unsigned long now = millis();
+      auto &p = game.probe_;
+      p.detectLast = now - (p.signaled ? p.signalAt : p.missAt);
+      p.detectMax = max(p.detectMax, p.detectLast);
+      p.detects++;
+      p.signaled = false;
+      Serial.printf("%s become active, detected in %lums.\n", name, p.detectLast);
+
       active_ = &game;
-      timer_.setInterval(game.ACTIVE_DELAY);
+      poll_.restart(pollDelay, now + pollDelay);
+      render_.restart(game.FRAME_DELAY, now);
     }
     failed_ = 0;
+    lastFresh_ = millis();
+    if (pollDelay != poll_.interval()) {
+      poll_.restart(pollDelay, lastFresh_ + pollDelay);  // follow the dynamics
+    }
     return true;  // stop polling other game
   }
 
@@ -54,38 +136,134 @@ bool Controller::pollGame(Game &game) {
     return false;
   }
 
-  // failed in game, check the failure count
-  if (++failed_ < game.MAX_FAILURE) {
+  // the network is down, keep showing the last data (marked stale) for a
+  // while, as it's most likely a short blip of the router
+  if (!online_ && millis() - lastFresh_ < static_cast<unsigned long>(OFFLINE_GRACE)) {
+    return true;
+  }
+
+  // failed in game, keep the last data (marked stale) for the grace period,
+  // and at least the failure count for the slow pollers
+  if (++failed_ < game.MAX_FAILURE || millis() - lastFresh_ < static_cast<unsigned long>(MODE_GONE_GRACE)) {
     return true;  // temporal failure, still in this game
   }
-  Serial.printf("%s is inactive.\n", game.name());
+  Serial.printf("%s is inactive.\n", name);
   active_ = nullptr;
-  timer_.setInterval(IDLE_DELAY);
+  game.probe_.spentUs = 0;  // ingested in game, not a probe cost
+
+  // probe the others right away, as before the game started
+  unsigned long now = millis();
+  for (size_t i = 0; i < gameCount_; i++) {
+    games_[i]->probe_.next = now;
+  }
+  auto &p = game.probe_;
+  p.missAt = p.seenAt = now;
+  p.seen = true;
+  p.interval = IDLE_DELAY;
+  p.next = now + p.interval;
   return false;
 }
 
-void Controller::pollGames() {
-  // poll current game
-  if ((active_ != nullptr) && pollGame(*active_)) {
-    return;
+// probe the games due, the most recently active and then the cheapest first
+Game *ControllerBase::nextProbe(unsigned long now) {
+  Game *best = nullptr;
+  for (size_t i = 0; i < gameCount_; i++) {
+    Game *g = games_[i];
+    if (static_cast<long>(now - g->probe_.next) < 0) {
+      continue;
+    }
+    if (best == nullptr) {
+      best = g;
+      continue;
+    }
+
+    const auto &a = g->probe_, &b = best->probe_;
+    if (a.seen != b.seen) {
+      best = a.seen ? g : best;
+    } else if (a.seen && a.seenAt != b.seenAt) {
+      best = (static_cast<long>(a.seenAt - b.seenAt) > 0) ? g : best;
+    } else if (a.costUs < b.costUs) {
+      best = g;
+    }
   }
+  return best;
+}
 
-  // probe games
+bool ControllerBase::probeDue(unsigned long now) {
   for (size_t i = 0; i < gameCount_; i++) {
-    if (pollGame(*games_[i])) {
-      return;
+    if (static_cast<long>(now - games_[i]->probe_.next) >= 0) {
+      return true;
     }
   }
+  return false;
+}
+
+// true if missed, to be probed again at probe_.next
+bool ControllerBase::probeMissed(Game &game, unsigned long now, unsigned long costUs, bool found) {
+  auto &p = game.probe_;
+  unsigned long cost = p.spentUs + costUs;
+  p.spentUs = 0;
+  p.costUs = (p.costUs == 0) ? cost : (p.costUs * 3 + cost) / 4;
+  if (found) {
+    return false;
+  }
+
+  if (state_ == GameState::BUSY) {
+    p.next = now + game.ACTIVE_DELAY;  // the answer is on the way
+    return false;
+  }
+
+  if (state_ == GameState::SERVER_DOWN && p.costUs >= CHEAP_PROBE) {
+    // back off the servers not even reachable, as it's costly to try
+    p.interval = min(max(p.interval * 2, static_cast<unsigned long>(IDLE_DELAY)), MAX_PROBE_DELAY);
+  } else {
+    p.interval = IDLE_DELAY;
+  }
+  p.next = now + p.interval;
+  p.missAt = now;
+  return true;
 }
 
-void Controller::realTimerCb() {
-  pollGames();
-  updateState();
+// probe it at once while idle, the packet is the first sign of the game
+void ControllerBase::signal(Game &game, unsigned long now) {
+  auto &p = game.probe_;
+  if (!p.signaled) {
+    p.signaled = true;
+    p.signalAt = now;
+  }
+  p.next = now;
+}
+
+bool ControllerBase::stale(unsigned long pollDelay) const {
+  return millis() - lastFresh_ > STALE_POLLS * pollDelay;
+}
+
+void ControllerBase::rendered(const char *name) {
+  if (!rendered_) {
+    rendered_ = true;
+    Serial.printf("First %s frame in %lums\n", name, millis());
+  }
+}
 
+unsigned long ControllerBase::nextDeadline(unsigned long next) {
+  next = earliest(next, report_.next());
+  if (active_ != nullptr) {
+    next = earliest(next, poll_.next());
+  } else {
+    for (size_t i = 0; i < gameCount_; i++) {
+      next = earliest(next, games_[i]->probe_.next);
+    }
+  }
   if (driving_) {
-    active_->freshDisplay(clock_.time());
-  } else if (!clock_.inDisplay()) {
-    clock_.freshDisplay();  // need to switch to clock mode (not driving, or inactive)
+    next = earliest(next, render_.next());
   }
-  // otherwise let clock_tick() to update the clock disp
+  if (disp_.ledDirty()) {
+    next = earliest(next, leds_.next());
+  }
+  return next;
+}
+
+void ControllerBase::reportSwitches() {
+  rollHour(millis());
+  DEBUG("Mode switches: %u, last hour: %u, this hour: %u\n", switches_, lastHourSwitches_, hourSwitches_);
 }
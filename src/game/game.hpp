@@ -7,80 +7,234 @@
 
 #pragma once
 
-#include <SoftwareTimer.h>
 #include "../../config.h"
 #include "../clock/ntp_clock.hpp"
 #include "../display/display.hpp"
+#include "../sched/deadline.hpp"
+#include "../sched/snapshot.hpp"
+#include "../sched/task.hpp"
 
 enum GameState {
   SERVER_DOWN,
   NOT_START,
+  BUSY,  // request in flight, no news yet
 
   READY,
   DRIVING,  // driving the truck
 };
 
+// a parse result, handed over from the ingest to the render as a whole
+template <typename State>
+struct Telemetry {
+  GameState result;
+  State state;
+};
+
+// The hand over of the telemetry from the ingest task of a game to the
+// controller: the poll takes each result once, and the frames render the
+// newest state. Lock-free, the ingest never waits for a frame in flush.
+template <typename State>
+class TelemetryHandoff {
+public:
+  // ingest side, the single writer
+  inline void publish(GameState result, const State &state) {
+    snapshot_.publish({ result, state });
+  }
+
+  // the last result is not taken yet, for an ingest paced by the polls
+  inline bool pending() const {
+    return snapshot_.version() != taken_.load(std::memory_order_relaxed);
+  }
+
+  // the result published since the last take, false if nothing new
+  bool take(GameState &result) {
+    uint32_t version;
+    if (!pending() || !snapshot_.read(view_, &version)) {
+      return false;
+    }
+    taken_.store(version, std::memory_order_relaxed);
+    result = view_.result;
+    return true;
+  }
+
+  // any result published since the last call, to wake the controller
+  inline bool published() {
+    uint32_t version = snapshot_.version();
+    bool published = version != seen_;
+    seen_ = version;
+    return published;
+  }
+
+  // the newest state to render, the last one read if raced by the ingest
+  inline const State *state() {
+    snapshot_.read(view_);
+    return &view_.state;
+  }
+
+private:
+  Snapshot<Telemetry<State>> snapshot_;
+  Telemetry<State> view_{};  // the render copy
+  std::atomic<uint32_t> taken_{};
+  uint32_t seen_{};
+};
+
+// A game is split in two halves: the ingest task receives and parses the
+// telemetry on its own, and hands the results over to the render half, run
+// by the controller on its poll and frame deadlines.
 class Game {
 public:
   virtual ~Game() {}
   virtual const char *name() const;
-  virtual GameState getTelemetry();
+  virtual GameState getTelemetry();  // take the ingest result, if any
   virtual void freshDisplay(time_t time);
+  virtual bool arrived() {  // new packets to ingest since the last call
+    return false;
+  }
+  virtual bool published() {  // new results ingested since the last call
+    return false;
+  }
   virtual void start() {}
   virtual void stop() {}
+  virtual void probeAt([[maybe_unused]] unsigned long at) {}  // the next probe, to have the data ready
+  virtual unsigned long pollDelay() const {  // data query interval in game, adaptive
+    return ACTIVE_DELAY;
+  }
+
+  // the data shown is outdated, e.g. the network is down
+  inline void setStale(bool stale) {
+    stale_ = stale;
+  }
+
+  // the ingest task, to be run by the TaskRunner
+  inline Task &ingestTask() {
+    return ingest_;
+  }
+
+  // run the ingest on the next tick, e.g. packets to parse
+  inline void ingestWake() {
+    ingest_.wake();
+  }
 
 public:
   const int MAX_FAILURE;   // max retries before idle
-  const int ACTIVE_DELAY;  // data query interval in game (ms)
+  const int ACTIVE_DELAY;  // base data query interval in game (ms)
+  const int FRAME_DELAY;   // dashboard frame interval (ms)
 
 protected:
-  explicit Game(int maxFailure, int activeDelay)
-    : MAX_FAILURE(maxFailure), ACTIVE_DELAY(activeDelay) {}
-};
+  explicit Game(const char *ingestName, int maxFailure, int activeDelay, int frameDelay)
+    : MAX_FAILURE(maxFailure), ACTIVE_DELAY(activeDelay), FRAME_DELAY(frameDelay), ingest_(ingestName, *this) {}
 
-class Controller {
-public:
-  Controller(NtpClock &clock, Game **games, size_t count);
+  // receive and parse the telemetry, run by the ingest task
+  virtual void ingest() {}
 
-  inline void tick() {
-    timer_.tick();
+  // when ingest() needs to run again, next if nothing to do before
+  virtual unsigned long ingestAt(unsigned long next) {
+    return next;
   }
 
-  inline void startGames() {
-    for (size_t i = 0; i < gameCount_; i++) {
-      games_[i]->start();
-    }
-  }
+protected:
+  bool stale_{};
+
+private:
+  friend class ControllerBase;
+  template <typename... Slots>
+  friend class Controller;
 
-  inline void stopGames() {
-    for (size_t i = 0; i < gameCount_; i++) {
-      games_[i]->stop();
+  class IngestTask : public Task {
+  public:
+    IngestTask(const char *name, Game &game)
+      : Task(name), game_(game) {}
+
+    inline void wake() {
+      wakeAt_ = now_;
     }
+
+  protected:
+    void run() override;
+
+  private:
+    static constexpr unsigned long IDLE_POLL = 1000;  // ms, woken up by the packets
+
+    Game &game_;
+  };
+
+  IngestTask ingest_;
+
+  // probe scheduling while idle, managed by the controller
+  struct Probe {
+    unsigned long next;      // when to probe
+    unsigned long interval;  // backoff on unreachable server
+    unsigned long costUs;    // average, ingest() included
+    unsigned long spentUs;   // in ingest() since the last probe
+    unsigned long missAt;    // the last probe not detecting the game
+    unsigned long signalAt;  // the first packet since then
+    bool signaled;
+    unsigned long seenAt;  // the last time active
+    bool seen;
+
+    // time-to-detect, from the first packet or the last miss
+    uint32_t detects;
+    unsigned long detectLast;
+    unsigned long detectMax;
+  } probe_{};
+};
+
+// The mode switch and the probe scheduling of the controller, apart from the
+// games: the Controller template in controller.hpp calls the games, and hands
+// the results over to here.
+class ControllerBase {
+public:
+  // the earlier one of next and the next deadline of the controller
+  unsigned long nextDeadline(unsigned long next);
+
+  inline bool driving() const {
+    return driving_;
   }
 
-private:
-  bool pollGame(Game &game);
-  void pollGames();
-  void realTimerCb();  // the actual timer cb
+protected:
+  ControllerBase(Display &disp, NtpClock &clock, Game *const *games, size_t count);
+
+  bool pollResult(Game &game, const char *name, unsigned long pollDelay);
+  bool probeMissed(Game &game, unsigned long now, unsigned long costUs, bool found);
+  Game *nextProbe(unsigned long now);
+  bool probeDue(unsigned long now);
+  void signal(Game &game, unsigned long now);
+  bool stale(unsigned long pollDelay) const;
+  void rendered(const char *name);
   void updateState();
+  void switchMode(bool driving, unsigned long now);
+  void rollHour(unsigned long now);
+  void reportSwitches();
 
-private:
+protected:
+  Display &disp_;
   NtpClock &clock_;
-  SoftwareTimer timer_;
 
-  Game **games_{};
+  // separate cadences on absolute deadlines
+  Deadline poll_;    // game telemetry
+  Deadline render_;  // dashboard frames
+  Deadline leds_;    // RGB LED refresh
+  Deadline report_;  // statistics
+
+  Game *const *games_{};  // for the probe states only, no calls
   size_t gameCount_{};
 
   Game *active_{};  // current active game
   bool driving_{};
   GameState state_{ GameState::SERVER_DOWN };
   int failed_{};
-
-private:
-  static Controller *instance_;
-  static void timerCb() {
-    if (instance_ != nullptr) {
-      instance_->realTimerCb();
-    }
-  }
+  unsigned long lastFresh_{};  // the last telemetry received
+  bool online_{};              // the network is up
+  bool rendered_{};            // the first game frame
+
+  // mode switch hysteresis
+  unsigned long modeAt_{};    // the last switch
+  unsigned long pausedAt_{};  // paused in game since
+  bool paused_{};
+
+  // mode switches, total and per hour
+  uint32_t switches_{};
+  uint32_t hourSwitches_{};
+  uint32_t lastHourSwitches_{};
+  unsigned long hourAt_{};
 };
@@ -0,0 +1,71 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Compile-time game selection: a game disabled in config.h is never
+// instantiated, so its code, packet buffers and sockets are not linked in.
+// The same for a dashboard without any of its games enabled.
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include "game.hpp"
+
+template <typename T, bool ENABLE>
+class GameSlot {
+public:
+  static constexpr bool ENABLED = true;
+
+  template <typename... Args>
+  explicit GameSlot(Args &&...args)
+    : game_(std::forward<Args>(args)...) {}
+
+  inline T *get() {
+    return &game_;
+  }
+
+private:
+  T game_;
+};
+
+// disabled, takes no space
+template <typename T>
+class GameSlot<T, false> {
+public:
+  static constexpr bool ENABLED = false;
+
+  template <typename... Args>
+  explicit GameSlot(Args &&...) {}
+
+  inline T *get() {
+    return nullptr;
+  }
+};
+
+// A dashboard for the games, passed to them as the dashboard itself.
+template <typename T, bool ENABLE>
+class DashSlot {
+public:
+  template <typename... Args>
+  explicit DashSlot(Args &&...args)
+    : dash_(std::forward<Args>(args)...) {}
+
+  inline operator T &() {
+    return dash_;
+  }
+
+private:
+  T dash_;
+};
+
+// no game to show, only passed to the disabled game slots
+template <typename T>
+class DashSlot<T, false> {
+public:
+  template <typename... Args>
+  explicit DashSlot(Args &&...) {}
+};
@@ -0,0 +1,102 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "boot_cache.hpp"
+#include <EEPROM.h>
+#include <cstring>
+#include "../utils.hpp"
+
+static constexpr uint32_t NETWORK_MAGIC = 0x4E455431;  // "NET1"
+static constexpr uint32_t EPOCH_MAGIC = 0x45504F31;    // "EPO1"
+
+struct StoredNetwork {
+  uint32_t magic;
+  BootCache::Network net;
+  uint32_t check;
+};
+
+struct RtcEpoch {
+  uint32_t magic;
+  uint32_t epoch;
+  uint32_t check;  // garbage after power on
+};
+
+// FNV-1a
+static uint32_t checksum(const void *data, size_t len) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ static_cast<const uint8_t *>(data)[i]) * 16777619u;
+  }
+  return hash;
+}
+
+#ifdef ESP8266
+static void rtcRead(RtcEpoch &rtc) {
+  ESP.rtcUserMemoryRead(0, reinterpret_cast<uint32_t *>(&rtc), sizeof(rtc));
+}
+
+static void rtcWrite(RtcEpoch &rtc) {
+  ESP.rtcUserMemoryWrite(0, reinterpret_cast<uint32_t *>(&rtc), sizeof(rtc));
+}
+#else
+#include <esp_attr.h>
+
+RTC_NOINIT_ATTR static RtcEpoch rtcEpoch;
+
+static void rtcRead(RtcEpoch &rtc) {
+  rtc = rtcEpoch;
+}
+
+static void rtcWrite(RtcEpoch &rtc) {
+  rtcEpoch = rtc;
+}
+#endif
+
+static bool loadStored(StoredNetwork &stored) {
+  EEPROM.begin(sizeof(stored));
+  EEPROM.get(0, stored);
+  EEPROM.end();
+  return stored.magic == NETWORK_MAGIC && stored.check == checksum(&stored.net, sizeof(stored.net));
+}
+
+bool BootCache::loadNetwork(Network &net) {
+  StoredNetwork stored;
+  if (!loadStored(stored)) {
+    return false;
+  }
+  net = stored.net;
+  return true;
+}
+
+void BootCache::saveNetwork(const Network &net) {
+  StoredNetwork stored;
+  if (loadStored(stored) && memcmp(&stored.net, &net, sizeof(net)) == 0) {
+    return;  // spare the flash
+  }
+
+  stored = { NETWORK_MAGIC, net, checksum(&net, sizeof(net)) };
+  EEPROM.begin(sizeof(stored));
+  EEPROM.put(0, stored);
+  bool ok = EEPROM.commit();
+  EEPROM.end();
+  DEBUG("Boot cache: network saved%s\n", ok ? "" : " failed");
+}
+
+unsigned long BootCache::loadEpoch() {
+  RtcEpoch rtc;
+  rtcRead(rtc);
+  if (rtc.magic != EPOCH_MAGIC || rtc.check != ~rtc.epoch) {
+    return 0;
+  }
+  // saved at most a second before the reset
+  return rtc.epoch + 1;
+}
+
+void BootCache::saveEpoch(unsigned long epoch) {
+  RtcEpoch rtc{ EPOCH_MAGIC, static_cast<uint32_t>(epoch), ~static_cast<uint32_t>(epoch) };
+  rtcWrite(rtc);
+}
@@ -0,0 +1,38 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+
+// The last known state for the fast boot. The network is kept in flash, as it
+// rarely changes. The time is kept in RTC memory, which survives the resets
+// but not the power off, as the time elapsed is unknown after that.
+class BootCache {
+public:
+  struct Network {
+    uint8_t bssid[6];
+    int32_t channel;  // 0 for unknown
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t mask;
+    uint32_t dns;
+  };
+
+  // returns false if nothing cached
+  static bool loadNetwork(Network &net);
+
+  // the flash is only written on change
+  static void saveNetwork(const Network &net);
+
+  // estimated time of this boot (millis() 0) from the time saved before the
+  // reset, 0 for unknown
+  static unsigned long loadEpoch();
+
+  // cheap enough to be called every second
+  static void saveEpoch(unsigned long epoch);
+};
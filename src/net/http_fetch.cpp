@@ -0,0 +1,273 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "http_fetch.hpp"
+#include <cstring>
+#include "../utils.hpp"
+
+static constexpr int HTTP_CONN_TIMEOUT = 100;  // timeout for connect
+static constexpr int HTTP_READ_TIMEOUT = 200;  // timeout for the whole response
+
+void HttpBody::begin(WiFiClient *client, long len, bool chunked) {
+  client_ = client;
+  chunked_ = chunked;
+  remaining_ = chunked ? 0 : len;
+  chunk_ = Chunk::HEADER;
+  lineLen_ = 0;
+}
+
+// Parse the chunk size line, returns true once the next chunk is ready or the
+// last chunk is passed. The CRLF after each chunk data is an empty line here.
+bool HttpBody::readChunkHeader() {
+  while (client_->available() > 0) {
+    char c = client_->read();
+    if (c != '\n') {
+      if (c != '\r' && lineLen_ < sizeof(line_) - 1) {
+        line_[lineLen_++] = c;
+      }
+      continue;
+    }
+
+    line_[lineLen_] = '\0';
+    bool empty = (lineLen_ == 0);
+    lineLen_ = 0;
+
+    if (chunk_ == Chunk::TRAILER) {
+      if (empty) {
+        chunk_ = Chunk::END;
+        return true;
+      }
+    } else if (!empty) {
+      remaining_ = strtol(line_, nullptr, 16);
+      if (remaining_ > 0) {
+        return true;
+      }
+      chunk_ = Chunk::TRAILER;  // the last chunk
+    }
+  }
+  return false;
+}
+
+int HttpBody::read(uint8_t *buf, size_t len) {
+  size_t total = 0;
+  while (total < len) {
+    if (chunked_ && remaining_ == 0 && chunk_ != Chunk::END) {
+      if (!readChunkHeader()) {
+        break;
+      }
+      continue;
+    }
+    if (remaining_ == 0) {
+      break;  // end of body
+    }
+
+    int avail = client_->available();
+    if (avail <= 0) {
+      break;
+    }
+    size_t n = min(static_cast<size_t>(avail), len - total);
+    if (remaining_ > 0) {
+      n = min(n, static_cast<size_t>(remaining_));
+    }
+
+    int r = client_->read(buf + total, n);
+    if (r <= 0) {
+      break;
+    }
+    total += r;
+    if (remaining_ > 0) {
+      remaining_ -= r;
+    }
+  }
+  return total;
+}
+
+bool HttpBody::ended() {
+  if (chunked_) {
+    return chunk_ == Chunk::END;
+  }
+  return (remaining_ == 0) || (remaining_ < 0 && client_->available() == 0 && !client_->connected());
+}
+
+// only plain "http://host[:port][/path]" is supported
+HttpFetch::HttpFetch(const char *url) {
+  static constexpr const char *SCHEME = "http://";
+  if (strncmp(url, SCHEME, strlen(SCHEME)) == 0) {
+    url += strlen(SCHEME);
+  }
+
+  const char *path = strchr(url, '/');
+  String hostPort = path ? String(url).substring(0, path - url) : String(url);
+
+  int colon = hostPort.indexOf(':');
+  if (colon >= 0) {
+    host_ = hostPort.substring(0, colon);
+    port_ = hostPort.substring(colon + 1).toInt();
+  } else {
+    host_ = hostPort;
+  }
+
+  request_ = String("GET ") + (path ? path : "/") + " HTTP/1.1\r\n"
+             + "Host: " + hostPort + "\r\n"
+             + "Connection: keep-alive\r\n"
+             + "\r\n";
+}
+
+void HttpFetch::get() {
+  if (busy()) {
+    return;
+  }
+  state_ = State::CONNECT;
+  start_ = millis();
+  code_ = 0;
+  contentLen_ = -1;
+  chunked_ = false;
+  keepAlive_ = true;  // HTTP/1.1 default
+  lineLen_ = 0;
+}
+
+// keep the connection if the rest of body can be drained, otherwise close it
+void HttpFetch::reset() {
+  if (state_ == State::READY && keepAlive_ && body_.framed()) {
+    state_ = State::DRAIN;
+    poll();
+    return;
+  }
+  stop();
+}
+
+void HttpFetch::stop() {
+  client_.stop();
+  state_ = State::IDLE;
+}
+
+void HttpFetch::fail(const char *reason) {
+  DEBUG("HTTP %s:%u failed: %s\n", host_.c_str(), port_, reason);
+  client_.stop();
+  state_ = State::FAILED;
+}
+
+// read a header line without blocking, returns true once the line completes
+bool HttpFetch::readLine() {
+  while (client_.available() > 0) {
+    char c = client_.read();
+    if (c == '\n') {
+      line_[lineLen_] = '\0';
+      lineLen_ = 0;
+      return true;
+    }
+    if (c != '\r' && lineLen_ < LINE_SIZE - 1) {
+      line_[lineLen_++] = c;
+    }
+  }
+  return false;
+}
+
+void HttpFetch::parseHeader() {
+  auto value = [this](const char *name) -> const char * {
+    size_t len = strlen(name);
+    if (strncasecmp(line_, name, len) != 0) {
+      return nullptr;
+    }
+    const char *v = line_ + len;
+    while (*v == ' ') {
+      v++;
+    }
+    return v;
+  };
+
+  const char *v;
+  if ((v = value("Content-Length:")) != nullptr) {
+    contentLen_ = atol(v);
+  } else if ((v = value("Transfer-Encoding:")) != nullptr) {
+    chunked_ = (strncasecmp(v, "chunked", 7) == 0);
+  } else if ((v = value("Connection:")) != nullptr) {
+    keepAlive_ = (strncasecmp(v, "close", 5) != 0);
+  }
+}
+
+void HttpFetch::poll() {
+  if (idle() || state_ == State::FAILED) {
+    return;
+  }
+
+  if (state_ >= State::HEADERS && (millis() - start_ > HTTP_READ_TIMEOUT)) {
+    if (state_ == State::DRAIN) {
+      stop();  // not worth waiting, just reconnect next time
+    } else {
+      fail("timeout");
+    }
+    return;
+  }
+
+  switch (state_) {
+    case State::CONNECT:
+      requests_++;
+      if (client_.connected()) {
+        reused_++;
+      } else {
+        // the only step that waits, but bounded by a short timeout
+        client_.stop();
+#ifdef ESP8266
+        client_.setTimeout(HTTP_CONN_TIMEOUT);
+        bool ok = client_.connect(host_.c_str(), port_);
+#else
+        bool ok = client_.connect(host_.c_str(), port_, HTTP_CONN_TIMEOUT);
+#endif
+        if (!ok) {
+          fail("connect");
+          return;
+        }
+        client_.setNoDelay(true);
+      }
+      state_ = State::SEND;
+      break;
+
+    case State::SEND:
+      if (client_.write(reinterpret_cast<const uint8_t *>(request_.c_str()), request_.length()) != request_.length()) {
+        fail("send");
+        return;
+      }
+      start_ = millis();
+      state_ = State::HEADERS;
+      break;
+
+    case State::HEADERS:
+      while (readLine()) {
+        if (code_ == 0) {
+          // status line: "HTTP/1.1 200 OK"
+          const char *sp = strchr(line_, ' ');
+          code_ = sp ? atoi(sp + 1) : -1;
+        } else if (line_[0] == '\0') {
+          rtt_ = millis() - start_;
+          DEBUG("HTTP %s:%u RTT: %lums, reuse rate: %d%%\n", host_.c_str(), port_, rtt_, reuseRate());
+          body_.begin(&client_, contentLen_, chunked_);
+          state_ = State::READY;
+          return;
+        } else {
+          parseHeader();
+        }
+      }
+      if (!client_.connected()) {
+        fail("closed");  // most likely a stale keep-alive connection
+      }
+      break;
+
+    case State::DRAIN: {
+      uint8_t buf[64];
+      while (body_.read(buf, sizeof(buf)) > 0) {
+      }
+      if (body_.ended()) {
+        state_ = State::IDLE;
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
@@ -0,0 +1,128 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+// Response body read straight from the socket, framed by Content-Length,
+// chunked encoding, or the end of connection.
+class HttpBody {
+public:
+  void begin(WiFiClient *client, long len, bool chunked);
+  int read(uint8_t *buf, size_t len);  // never waits, 0 for no data yet
+  bool ended();
+
+  // the end of body is known without closing the connection
+  inline bool framed() const {
+    return chunked_ || remaining_ >= 0;
+  }
+
+private:
+  bool readChunkHeader();
+
+private:
+  enum class Chunk : uint8_t {
+    HEADER,   // chunk size line
+    TRAILER,  // after the last chunk
+    END,
+  };
+
+  WiFiClient *client_{};
+  long remaining_{};  // of the whole body or the current chunk, -1 for unknown
+  bool chunked_{};
+  Chunk chunk_{};
+  char line_[16]{};  // long chunk extensions are truncated
+  size_t lineLen_{};
+};
+
+// Lean HTTP/1.1 GET client of a fixed URL. The request is rendered once, and
+// sent over a persistent connection which is only reconnected on error. The
+// request is advanced a little on each poll(), so the caller never waits for
+// a slow or absent server.
+class HttpFetch {
+public:
+  enum class State {
+    IDLE,
+    CONNECT,
+    SEND,
+    HEADERS,
+    DRAIN,  // discarding the unread body to reuse the connection
+
+    READY,   // headers received, body ready to read
+    FAILED,  // connection or protocol error
+  };
+
+  explicit HttpFetch(const char *url);
+
+  void get();
+  void poll();
+  void reset();  // drop the response and get ready for the next request
+  void stop();
+
+  inline State state() const {
+    return state_;
+  }
+
+  inline bool idle() const {
+    return state_ == State::IDLE;
+  }
+
+  inline bool busy() const {
+    return state_ > State::IDLE && state_ < State::READY;
+  }
+
+  inline int code() const {
+    return code_;
+  }
+
+  // the body could be only partially received, read what is available on each
+  // poll() until ended, the request fails on timeout
+  inline HttpBody &body() {
+    return body_;
+  }
+
+  // round trip time of the last response (ms)
+  inline unsigned long rtt() const {
+    return rtt_;
+  }
+
+  // percentage of the requests sent over a reused connection
+  inline int reuseRate() const {
+    return (requests_ > 0) ? reused_ * 100 / requests_ : 0;
+  }
+
+private:
+  bool readLine();
+  void parseHeader();
+  void fail(const char *reason);
+
+private:
+  static constexpr size_t LINE_SIZE = 64;  // long headers are truncated
+
+  String host_;
+  uint16_t port_{ 80 };
+  String request_;  // pre-rendered request
+
+  WiFiClient client_{};
+  State state_{ State::IDLE };
+  unsigned long start_{};  // request start time
+
+  int code_{};
+  long contentLen_{ -1 };  // -1 for unknown
+  bool chunked_{};
+  bool keepAlive_{};
+  char line_[LINE_SIZE]{};
+  size_t lineLen_{};
+  HttpBody body_{};
+
+  // statistics
+  unsigned long rtt_{};
+  uint32_t requests_{};
+  uint32_t reused_{};
+};
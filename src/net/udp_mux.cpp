@@ -0,0 +1,235 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "udp_mux.hpp"
+#include <cstring>
+#include "../utils.hpp"
+#include "../sched/idle.hpp"
+
+#ifdef ESP8266
+#include <lwip/pbuf.h>
+#include <lwip/udp.h>
+
+// the lwIP callbacks run in the same context as loop(), never preempt it
+struct UdpLock {
+  UdpLock() {}
+};
+
+struct Listener {
+  uint16_t port;
+  udp_pcb *pcb;
+};
+
+static void onRecv(void *arg, udp_pcb *, pbuf *p, const ip_addr_t *, u16_t) {
+  auto *listener = static_cast<Listener *>(arg);
+  if (p->len == p->tot_len) {
+    UdpMux::dispatch(listener->port, static_cast<const uint8_t *>(p->payload), p->len);
+  } else {
+    static uint8_t scratch[512];  // chained pbuf, larger than any game packet
+    size_t len = pbuf_copy_partial(p, scratch, sizeof(scratch), 0);
+    UdpMux::dispatch(listener->port, scratch, len);
+  }
+  pbuf_free(p);
+}
+
+static bool listenOn(Listener &l) {
+  l.pcb = udp_new();
+  if (l.pcb == nullptr) {
+    return false;
+  }
+  if (udp_bind(l.pcb, IP_ADDR_ANY, l.port) != ERR_OK) {
+    udp_remove(l.pcb);
+    l.pcb = nullptr;
+    return false;
+  }
+  udp_recv(l.pcb, onRecv, &l);
+  return true;
+}
+
+static void closeOn(Listener &l) {
+  if (l.pcb != nullptr) {
+    udp_remove(l.pcb);
+    l.pcb = nullptr;
+  }
+}
+#else
+#include <AsyncUDP.h>
+
+// the AsyncUDP callbacks run in its own task
+static portMUX_TYPE udpMux = portMUX_INITIALIZER_UNLOCKED;
+
+struct UdpLock {
+  UdpLock() {
+    portENTER_CRITICAL(&udpMux);
+  }
+  ~UdpLock() {
+    portEXIT_CRITICAL(&udpMux);
+  }
+};
+
+struct Listener {
+  uint16_t port;
+  AsyncUDP udp;
+};
+
+static bool listenOn(Listener &l) {
+  if (!l.udp.listen(l.port)) {
+    return false;
+  }
+  uint16_t port = l.port;
+  l.udp.onPacket([port](AsyncUDPPacket &pkt) {
+    UdpMux::dispatch(port, pkt.data(), pkt.length());
+  });
+  return true;
+}
+
+static void closeOn(Listener &l) {
+  l.udp.close();
+}
+#endif
+
+UdpQueue *UdpMux::queues_[MAX_QUEUES]{};
+uint32_t UdpMux::unknown_{};
+
+static Listener listeners[UdpMux::MAX_QUEUES]{};  // port 0 for unused
+
+bool UdpQueue::begin() {
+  return UdpMux::attach(this);
+}
+
+void UdpQueue::end() {
+  UdpMux::detach(this);
+  UdpLock lock;
+  count_ = 0;
+  arrived_ = false;
+}
+
+void UdpQueue::push(const uint8_t *data, size_t len) {
+  if (count_ == depth_) {
+    head_ = (head_ + 1) % depth_;
+    count_--;
+    if (read_ == Read::LATEST) {
+      overwritten_++;  // popLatest() would have skipped it anyway
+    } else {
+      dropped_++;
+    }
+  }
+
+  size_t slot = (head_ + count_) % depth_;
+  len = min(len, size_);
+  memcpy(buf_ + slot * size_, data, len);
+  lens_[slot] = len;
+  count_++;
+  arrived_ = true;
+}
+
+int UdpQueue::pop(uint8_t *buf, size_t size) {
+  UdpLock lock;
+  if (count_ == 0) {
+    return 0;
+  }
+
+  size_t len = min(static_cast<size_t>(lens_[head_]), size);
+  memcpy(buf, buf_ + head_ * size_, len);
+  head_ = (head_ + 1) % depth_;
+  count_--;
+  return len;
+}
+
+bool UdpQueue::arrived() {
+  UdpLock lock;
+  bool arrived = arrived_;
+  arrived_ = false;
+  return arrived;
+}
+
+bool UdpMux::attach(UdpQueue *queue) {
+  uint16_t port = queue->port();
+  Listener *listener = nullptr;
+  for (auto &l : listeners) {
+    if (l.port == port) {
+      listener = &l;  // shared with other games
+      break;
+    }
+    if (l.port == 0 && listener == nullptr) {
+      listener = &l;
+    }
+  }
+  if (listener == nullptr) {
+    return false;
+  }
+
+  if (listener->port != port) {
+    listener->port = port;
+    if (!listenOn(*listener)) {
+      Serial.printf("Failed to listen on UDP port %u\n", port);
+      listener->port = 0;
+      return false;
+    }
+  }
+
+  UdpLock lock;
+  UdpQueue **free = nullptr;
+  for (auto &q : queues_) {
+    if (q == queue) {
+      return true;  // already attached
+    }
+    if (q == nullptr && free == nullptr) {
+      free = &q;
+    }
+  }
+  if (free == nullptr) {
+    return false;
+  }
+  *free = queue;
+  return true;
+}
+
+void UdpMux::detach(UdpQueue *queue) {
+  bool shared = false;
+  {
+    UdpLock lock;
+    for (auto &q : queues_) {
+      if (q == queue) {
+        q = nullptr;
+      } else if (q != nullptr && q->port() == queue->port()) {
+        shared = true;
+      }
+    }
+  }
+
+  if (!shared) {
+    for (auto &l : listeners) {
+      if (l.port == queue->port()) {
+        closeOn(l);
+        l.port = 0;
+      }
+    }
+  }
+}
+
+void UdpMux::dispatch(uint16_t port, const uint8_t *data, size_t len) {
+  bool queued = false;
+  {
+    UdpLock lock;
+    for (auto *q : queues_) {
+      if (q != nullptr && q->port() == port && q->accept_(len)) {
+        q->push(data, len);
+        queued = true;
+        break;
+      }
+    }
+    if (!queued) {
+      unknown_++;
+    }
+  }
+
+  // not in the critical section, where no FreeRTOS call is allowed on ESP32
+  if (queued) {
+    IdleManager::wake();
+  }
+}
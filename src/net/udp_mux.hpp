@@ -0,0 +1,123 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+
+// Received packets of a game, filled by UdpMux from the network stack as soon
+// as they arrive. The oldest packet is dropped on overflow.
+class UdpQueue {
+public:
+  using Accept = bool (*)(size_t len);
+
+  // how the queue is read, for the overflow statistics
+  enum class Read : uint8_t {
+    ALL,     // every packet counts, e.g. deltas
+    LATEST,  // by popLatest(), an overflow only skips the packets ahead of it
+  };
+
+  bool begin();  // start receiving on the port
+  void end();
+
+  // copy out the oldest packet, returns its length, 0 for empty
+  int pop(uint8_t *buf, size_t size);
+
+  // Drain the queue and leave only the newest packet in buf, returns its
+  // length. hold(len) is called on each packet in buf, for the aggregates
+  // (e.g. peak values) which must not be lost with the skipped packets.
+  template <typename F>
+  int popLatest(uint8_t *buf, size_t size, F &&hold) {
+    int latest = 0, len;
+    while ((len = pop(buf, size)) > 0) {
+      if (latest > 0) {
+        coalesced_++;
+      }
+      hold(len);
+      latest = len;
+    }
+    return latest;
+  }
+
+  // any packet queued since the last call
+  bool arrived();
+
+  inline uint16_t port() const {
+    return port_;
+  }
+
+  // packets dropped on overflow
+  inline uint32_t dropped() const {
+    return dropped_;
+  }
+
+  // packets skipped by popLatest(), or overwritten ahead of it
+  inline uint32_t coalesced() const {
+    return coalesced_ + overwritten_;
+  }
+
+protected:
+  UdpQueue(uint16_t port, Accept accept, Read read, uint8_t *buf, size_t size, uint16_t *lens, size_t depth)
+    : port_(port), accept_(accept), read_(read), buf_(buf), size_(size), lens_(lens), depth_(depth) {}
+
+private:
+  friend class UdpMux;
+  void push(const uint8_t *data, size_t len);
+
+private:
+  uint16_t port_{};
+  Accept accept_{};  // the packet sizes of this game
+  Read read_{};
+
+  uint8_t *buf_{};  // depth_ slots of size_ bytes
+  size_t size_{};   // longer packets are truncated
+  uint16_t *lens_{};
+  size_t depth_{};
+
+  size_t head_{};  // the oldest packet
+  size_t count_{};
+  volatile bool arrived_{};
+  uint32_t dropped_{};
+  uint32_t coalesced_{};
+  uint32_t overwritten_{};  // on overflow, not dropped for Read::LATEST
+};
+
+template <size_t SIZE, size_t DEPTH = 4>
+class UdpQueueOf : public UdpQueue {
+public:
+  UdpQueueOf(uint16_t port, Accept accept, Read read = Read::ALL)
+    : UdpQueue(port, accept, read, storage_, SIZE, lengths_, DEPTH) {}
+
+private:
+  uint8_t storage_[SIZE * DEPTH]{};
+  uint16_t lengths_[DEPTH]{};
+};
+
+// One receive callback for all the game ports, which dispatches each packet
+// to the queue accepting its port and size. Games sharing a port share the
+// listener too, and are told apart by the packet size.
+class UdpMux {
+public:
+  static constexpr size_t MAX_QUEUES = 4;
+
+  // packets not accepted by any queue
+  static inline uint32_t unknown() {
+    return unknown_;
+  }
+
+  // called by the network stack on each packet
+  static void dispatch(uint16_t port, const uint8_t *data, size_t len);
+
+private:
+  friend class UdpQueue;
+  static bool attach(UdpQueue *queue);
+  static void detach(UdpQueue *queue);
+
+private:
+  static UdpQueue *queues_[MAX_QUEUES];
+  static uint32_t unknown_;
+};
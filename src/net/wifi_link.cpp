@@ -0,0 +1,88 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "wifi_link.hpp"
+#include <cstring>
+#include "../../config.h"
+
+#ifdef ESP8266
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#endif
+
+void WifiLink::joined() {
+  unsigned long took = now_ - downAt_;
+  Serial.printf(" Local IP: %s, took %lums, %d attempt(s)%s\n", WiFi.localIP().toString().c_str(),
+                took, attempts_, fast_ ? ", fast rejoin" : "");
+
+  if (joined_) {
+    reconnects_++;
+    fastRejoins_ += fast_ ? 1 : 0;
+    lastMs_ = took;
+    maxMs_ = max(maxMs_, took);
+    Serial.printf("WiFi reconnects: %u (fast: %u), last: %lums, max: %lums\n",
+                  reconnects_, fastRejoins_, lastMs_, maxMs_);
+  }
+
+  joined_ = true;
+
+  // remember the AP for the next rejoin
+  memcpy(net_.bssid, WiFi.BSSID(), sizeof(net_.bssid));
+  net_.channel = WiFi.channel();
+  net_.ip = WiFi.localIP();
+  net_.gateway = WiFi.gatewayIP();
+  net_.mask = WiFi.subnetMask();
+  net_.dns = WiFi.dnsIP();
+  if (FAST_BOOT) {
+    BootCache::saveNetwork(net_);
+  }
+}
+
+void WifiLink::run() {
+  TASK_BEGIN();
+  WiFi.persistent(false);  // no flash write on each begin()
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(false);  // reconnect with our own backoff
+  if (FAST_BOOT && BootCache::loadNetwork(net_)) {
+    Serial.printf("Fast boot: channel %d\n", net_.channel);
+  }
+
+  for (;;) {
+    downAt_ = now_;
+    backoff_ = MIN_BACKOFF;
+    for (attempts_ = 1;; attempts_++) {
+      // try the known AP first, fall back to scan in case it's moved
+      fast_ = (attempts_ == 1 && net_.channel != 0);
+      if (FAST_BOOT_IP && fast_ && net_.ip != 0) {
+        WiFi.config(net_.ip, net_.gateway, net_.mask, net_.dns);  // skip DHCP
+      } else if (FAST_BOOT_IP) {
+        WiFi.config(0u, 0u, 0u);  // back to DHCP
+      }
+      Serial.printf("Connecting to %s%s .", ssid_, fast_ ? " (fast)" : "");
+      WiFi.begin(ssid_, password_, fast_ ? net_.channel : 0, fast_ ? net_.bssid : nullptr);
+
+      TASK_AWAIT_FOR(WiFi.status() == WL_CONNECTED, fast_ ? FAST_TIMEOUT : SCAN_TIMEOUT);
+      if (!timedOut()) {
+        break;
+      }
+
+      Serial.printf(" failed, retry in %lums\n", backoff_);
+      WiFi.disconnect();
+      TASK_SLEEP(backoff_);
+      backoff_ = min(backoff_ * 2, MAX_BACKOFF);
+    }
+
+    joined();
+    onUp_();
+
+    TASK_AWAIT_POLL(WiFi.status() != WL_CONNECTED, LINK_POLL);
+    Serial.println("WiFi disconnected.");
+    onDown_();
+  }
+  TASK_END();
+}
@@ -0,0 +1,75 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+#include "boot_cache.hpp"
+#include "../sched/task.hpp"
+
+// Keep the Wi-Fi connected, and start/stop the network services with it.
+//
+// Reconnects in background with exponential backoff, the first attempt
+// rejoins the last AP directly with its BSSID and channel, skipping the scan.
+// The AP is cached across boots with FAST_BOOT.
+class WifiLink : public Task {
+public:
+  using Callback = std::function<void()>;
+
+  WifiLink(const char *ssid, const char *password, Callback onUp, Callback onDown)
+    : Task("wifi"), ssid_(ssid), password_(password), onUp_(onUp), onDown_(onDown) {}
+
+  // reconnect metrics, from the link lost to up again
+  inline uint32_t reconnects() const {
+    return reconnects_;
+  }
+
+  inline uint32_t fastRejoins() const {
+    return fastRejoins_;
+  }
+
+  inline unsigned long lastReconnectMs() const {
+    return lastMs_;
+  }
+
+  inline unsigned long maxReconnectMs() const {
+    return maxMs_;
+  }
+
+protected:
+  void run() override;
+
+private:
+  void joined();
+
+private:
+  static constexpr unsigned long FAST_TIMEOUT = 2000;  // ms, rejoin the known AP
+  static constexpr unsigned long SCAN_TIMEOUT = 8000;  // ms, with a full scan
+  static constexpr unsigned long MIN_BACKOFF = 500;    // ms
+  static constexpr unsigned long MAX_BACKOFF = 30000;  // ms
+  static constexpr unsigned long LINK_POLL = 500;      // check for disconnection
+
+  const char *ssid_;
+  const char *password_;
+  Callback onUp_;
+  Callback onDown_;
+
+  BootCache::Network net_{};  // the last AP joined
+  bool joined_{};              // since boot
+
+  bool fast_{};  // rejoin without scan in this attempt
+  int attempts_{};
+  unsigned long backoff_{};
+  unsigned long downAt_{};
+
+  // statistics
+  uint32_t reconnects_{};
+  uint32_t fastRejoins_{};
+  unsigned long lastMs_{};
+  unsigned long maxMs_{};
+};
@@ -0,0 +1,41 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "adaptive_rate.hpp"
+#include <algorithm>
+
+void AdaptiveRate::sample(Activity activity, unsigned long rtt) {
+  unsigned long floor = std::min(std::max(min_, rtt * RTT_FACTOR), max_);
+  delay_ = std::max(delay_, floor);  // the server is slower now
+
+  unsigned long target;
+  switch (activity) {
+    case Activity::DYNAMIC:
+      target = floor;
+      break;
+    case Activity::STEADY:
+      target = base_;
+      break;
+    default:
+      target = max_;
+      break;
+  }
+  target = std::max(target, floor);
+
+  if (target < delay_) {
+    delay_ = target;  // speed up at once
+    calm_ = 0;
+  } else if (target > delay_) {
+    // slow down step by step, only after calm for a while
+    if (++calm_ >= CALM_HOLD) {
+      delay_ = std::min(delay_ * 2, target);
+      calm_ = 0;
+    }
+  } else {
+    calm_ = 0;
+  }
+}
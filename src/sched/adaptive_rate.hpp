@@ -0,0 +1,44 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstdint>
+
+// Polling interval following the vehicle dynamics: fast at once when the
+// state changes quickly, back to slow only after a calm hold (hysteresis).
+class AdaptiveRate {
+public:
+  enum class Activity : uint8_t {
+    IDLE,     // parked, paused or in menus
+    STEADY,   // cruising
+    DYNAMIC,  // speed, rpm or indicators changing quickly
+  };
+
+  AdaptiveRate(unsigned long minDelay, unsigned long baseDelay, unsigned long maxDelay)
+    : min_(minDelay), base_(baseDelay), max_(maxDelay), delay_(baseDelay) {}
+
+  // feed the activity of each poll, with the request round trip if any
+  void sample(Activity activity, unsigned long rtt = 0);
+
+  inline unsigned long delay() const {
+    return delay_;
+  }
+
+private:
+  static constexpr int CALM_HOLD = 4;   // calm samples to slow down a step
+  static constexpr int RTT_FACTOR = 2;  // no faster than the server answers
+
+  const unsigned long min_;
+  const unsigned long base_;
+  const unsigned long max_;
+
+  unsigned long delay_;
+  int calm_{};
+};
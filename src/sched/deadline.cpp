@@ -0,0 +1,54 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "deadline.hpp"
+
+bool Deadline::due(unsigned long now) {
+  long late = now - next_;
+  if (late < 0) {
+    return false;
+  }
+
+  runs_++;
+  lateSum_ += late;
+  lateMax_ = max(lateMax_, static_cast<unsigned long>(late));
+  lastRun_ = now;
+
+  next_ += interval_;
+  if (static_cast<long>(now - next_) < 0) {
+    return true;  // on time, or within the period
+  }
+
+  // missed the whole periods, keep on the grid
+  unsigned long missed = (now - next_) / interval_ + 1;
+  next_ += missed * interval_;
+  skipped_ += missed;
+  return true;
+}
+
+void Deadline::restart(unsigned long interval, unsigned long first) {
+  interval_ = interval;
+  next_ = first;
+}
+
+void Deadline::wake(unsigned long now, unsigned long minGap) {
+  if (now - lastRun_ >= minGap && static_cast<long>(next_ - now) > 0) {
+    next_ = now;
+  }
+}
+
+Deadline::Stats Deadline::stats() {
+  Stats s{
+    .runs = runs_,
+    .skipped = skipped_,
+    .lateAvg = (runs_ > 0) ? lateSum_ / runs_ : 0,
+    .lateMax = lateMax_,
+  };
+  runs_ = skipped_ = 0;
+  lateSum_ = lateMax_ = 0;
+  return s;
+}
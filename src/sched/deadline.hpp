@@ -0,0 +1,58 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+
+// Periodic deadline on a fixed grid: the next deadline is advanced from the
+// previous one instead of from the late run, so the rate never drifts with
+// the time spent in the work itself. The missed periods are dropped, not run
+// back-to-back, a late frame is never followed by extra ones.
+class Deadline {
+public:
+  struct Stats {
+    uint32_t runs;
+    uint32_t skipped;  // missed periods not run
+    unsigned long lateAvg;
+    unsigned long lateMax;
+  };
+
+  explicit Deadline(unsigned long interval)
+    : interval_(interval) {}
+
+  // true if the deadline is reached, and the next one is scheduled
+  bool due(unsigned long now);
+
+  // switch to a new interval, the next deadline is at first
+  void restart(unsigned long interval, unsigned long first);
+
+  // pull the next deadline to now, if not run in the last minGap
+  void wake(unsigned long now, unsigned long minGap);
+
+  inline unsigned long next() const {
+    return next_;
+  }
+
+  inline unsigned long interval() const {
+    return interval_;
+  }
+
+  // statistics since the last call
+  Stats stats();
+
+private:
+  unsigned long interval_{};
+  unsigned long next_{};
+  unsigned long lastRun_{};
+
+  // statistics
+  uint32_t runs_{};
+  uint32_t skipped_{};
+  unsigned long lateSum_{};
+  unsigned long lateMax_{};
+};
@@ -0,0 +1,94 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "idle.hpp"
+#include "../utils.hpp"
+
+#ifdef ESP8266
+#include <ESP8266WiFi.h>
+#include <coredecls.h>
+
+// the network callbacks only run while the loop yields, so no race here
+static volatile bool wakeup = false;
+
+void IdleManager::wake() {
+  wakeup = true;
+  esp_schedule();  // resume the loop from esp_delay()
+}
+
+static bool idleSleep(unsigned long ms) {
+  if (!wakeup) {
+    esp_delay(ms, [] {
+      return !wakeup;
+    });
+  }
+  bool woken = wakeup;
+  wakeup = false;
+  return woken;
+}
+
+static void radioPowerSave(bool sleep) {
+  WiFi.setSleepMode(sleep ? WIFI_LIGHT_SLEEP : WIFI_NONE_SLEEP);
+}
+#else
+#include <WiFi.h>
+
+static TaskHandle_t loopTask = nullptr;
+
+void IdleManager::wake() {
+  TaskHandle_t task = loopTask;
+  if (task != nullptr) {
+    xTaskNotifyGive(task);
+  }
+}
+
+// the packets before the sleep are counted too, just a spurious wakeup
+static bool idleSleep(unsigned long ms) {
+  loopTask = xTaskGetCurrentTaskHandle();
+  return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms)) > 0;
+}
+
+static void radioPowerSave(bool sleep) {
+  WiFi.setSleep(sleep);  // modem sleep
+}
+#endif
+
+void IdleManager::sleepUntil(unsigned long deadline) {
+  long ms = deadline - millis();
+  if (ms >= static_cast<long>(MIN_SLEEP)) {
+    unsigned long start = micros();
+    woken_ += idleSleep(min(static_cast<unsigned long>(ms), MAX_SLEEP)) ? 1 : 0;
+    slept_ += micros() - start;
+    sleeps_++;
+  }
+
+  if (micros() - windowStart_ >= REPORT_DELAY * 1000000UL) {
+    report();
+  }
+}
+
+void IdleManager::radioSleep(bool sleep) {
+  LAZY_EXEC(false, sleep, radioSleep_, {
+    radioPowerSave(sleep);
+    DEBUG("Radio sleep: %s\n", sleep ? "on" : "off");
+  });
+}
+
+void IdleManager::report() {
+  unsigned long window = micros() - windowStart_;
+  DEBUG("CPU duty cycle: %lu%%, sleeps: %u, woken by packets: %u\n",
+        100 - slept_ / (window / 100), sleeps_, woken_);
+  tasks_.forEach([](Task &t) {
+    DEBUG("Task %s runs: %u, busy: %lums, max: %luus%s\n",
+          t.name(), t.runs(), t.busyUs() / 1000, t.maxUs(), t.finished() ? " (finished)" : "");
+    t.resetStats();
+  });
+
+  windowStart_ += window;
+  slept_ = 0;
+  sleeps_ = woken_ = 0;
+}
@@ -0,0 +1,56 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#pragma once
+
+#include <Arduino.h>
+#include "task.hpp"
+
+// the earlier one of two millis() deadlines, safe across the wrap around
+static inline unsigned long earliest(unsigned long a, unsigned long b) {
+  return (static_cast<long>(a - b) < 0) ? a : b;
+}
+
+// Tickless idle: instead of spinning the loop, sleep until the earliest
+// deadline of all the components, or until woken up by a packet. The CPU idles
+// in the OS while sleeping, and the radio sleeps too when the latency doesn't
+// matter.
+class IdleManager {
+public:
+  explicit IdleManager(TaskRunner &tasks)
+    : tasks_(tasks) {}
+
+  // the farthest deadline to sleep until, start of the fold over components
+  inline unsigned long horizon() const {
+    return millis() + MAX_SLEEP;
+  }
+
+  void sleepUntil(unsigned long deadline);
+
+  // radio power save between the AP beacons, adds latency to the packets
+  void radioSleep(bool sleep);
+
+  // wake up from sleepUntil(), safe from the network stack
+  static void wake();
+
+private:
+  void report();
+
+private:
+  static constexpr unsigned long MAX_SLEEP = 1000;   // ms
+  static constexpr unsigned long MIN_SLEEP = 2;      // ms, not worth a sleep
+  static constexpr unsigned long REPORT_DELAY = 60;  // seconds
+
+  TaskRunner &tasks_;     // reported with the duty cycle
+  int radioSleep_{ -1 };  // unknown on start
+
+  // statistics
+  unsigned long windowStart_{};  // us
+  unsigned long slept_{};        // us
+  uint32_t sleeps_{};
+  uint32_t woken_{};  // by the packets
+};
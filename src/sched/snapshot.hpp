@@ -0,0 +1,75 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Lock-free hand over of the game state from the ingest (packet parsing) to
+// the render (I2C flushing): a seqlock over a double buffer. The single writer
+// never waits, and always fills the slot not being published, so a reader
+// only retries if a whole new state is published during its copy.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+class Snapshot {
+  static_assert(std::is_trivially_copyable<T>::value, "Snapshot needs plain data");
+
+public:
+  // single writer only
+  void publish(const T &value) {
+    uint32_t next = seq_.load(std::memory_order_relaxed) + 1;
+    std::atomic_thread_fence(std::memory_order_release);  // after the last publish
+    memcpy(&slots_[next & 1], &value, sizeof(T));
+    seq_.store(next, std::memory_order_release);
+  }
+
+  // Copy out the last published state and its version, out is untouched if
+  // nothing published yet, or the writer keeps racing ahead.
+  bool read(T &out, uint32_t *version = nullptr) const {
+    for (int i = 0; i < MAX_RETRY; i++) {
+      uint32_t seq = seq_.load(std::memory_order_acquire);
+      if (seq == 0) {
+        return false;
+      }
+
+      T copy;
+      memcpy(&copy, &slots_[seq & 1], sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == seq) {
+        out = copy;
+        if (version != nullptr) {
+          *version = seq;
+        }
+        return true;
+      }
+      retries_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+  }
+
+  // increased on each publish, 0 for none
+  inline uint32_t version() const {
+    return seq_.load(std::memory_order_acquire);
+  }
+
+  // reads raced by the writer
+  inline uint32_t retries() const {
+    return retries_.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr int MAX_RETRY = 4;
+
+  T slots_[2]{};
+  std::atomic<uint32_t> seq_{};
+  mutable std::atomic<uint32_t> retries_{};
+};
@@ -0,0 +1,47 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include "task.hpp"
+
+void TaskRunner::add(Task &task) {
+  Task **tail = &head_;
+  while (*tail != nullptr) {
+    if (*tail == &task) {
+      return;
+    }
+    tail = &(*tail)->next_;
+  }
+  *tail = &task;
+  task.wakeAt_ = ms_();
+}
+
+void TaskRunner::tick() {
+  for (Task *t = head_; t != nullptr; t = t->next_) {
+    unsigned long now = ms_();
+    if (t->finished() || !Task::reached(now, t->wakeAt_)) {
+      continue;
+    }
+
+    unsigned long start = us_();
+    t->now_ = now;
+    t->run();
+    unsigned long used = us_() - start;
+
+    t->runs_++;
+    t->busyUs_ += used;
+    t->maxUs_ = (used > t->maxUs_) ? used : t->maxUs_;
+  }
+}
+
+unsigned long TaskRunner::nextDeadline(unsigned long next) const {
+  for (const Task *t = head_; t != nullptr; t = t->next_) {
+    if (!t->finished() && static_cast<long>(t->wakeAt_ - next) < 0) {
+      next = t->wakeAt_;
+    }
+  }
+  return next;
+}
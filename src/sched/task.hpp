@@ -0,0 +1,169 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Stackless cooperative tasks (protothread style), as C++20 coroutines are not
+// available on the ESP toolchains. run() is re-entered at the last TASK_*()
+// point, so the locals are lost across them, keep the state in members.
+//
+// This file has no Arduino dependencies, so it can be built on the host.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#define TASK_BEGIN() \
+  switch (resume_) { \
+    case 0:
+
+#define TASK_END() \
+  } \
+  resume_ = -1; \
+  return
+
+// give the other tasks a chance, resume on the next tick
+#define TASK_YIELD() \
+  do { \
+    resume_ = __LINE__; \
+    wakeAt_ = now_; \
+    return; \
+    case __LINE__:; \
+  } while (0)
+
+#define TASK_SLEEP(ms) \
+  do { \
+    wakeAt_ = now_ + (ms); \
+    resume_ = __LINE__; \
+    return; \
+    case __LINE__:; \
+  } while (0)
+
+// wait for the condition (socket readiness, I2C completion...), checked
+// every poll ms, a longer poll lets the CPU sleep longer
+#define TASK_AWAIT_POLL(cond, poll) \
+  do { \
+    resume_ = __LINE__; \
+    [[fallthrough]]; \
+    case __LINE__: \
+      if (!(cond)) { \
+        wakeAt_ = now_ + (poll); \
+        return; \
+      } \
+  } while (0)
+
+#define TASK_AWAIT(cond) TASK_AWAIT_POLL(cond, TASK_POLL)
+
+// same as TASK_AWAIT(), but give up after ms, check with timedOut()
+#define TASK_AWAIT_FOR(cond, ms) \
+  do { \
+    timeout_ = now_ + (ms); \
+    resume_ = __LINE__; \
+    [[fallthrough]]; \
+    case __LINE__: \
+      timedOut_ = false; \
+      if (cond) { \
+        break; \
+      } \
+      if (Task::reached(now_, timeout_)) { \
+        timedOut_ = true; \
+        break; \
+      } \
+      wakeAt_ = now_ + TASK_POLL; \
+      return; \
+  } while (0)
+
+class Task {
+public:
+  explicit Task(const char *name)
+    : name_(name) {}
+  virtual ~Task() {}
+
+  inline const char *name() const {
+    return name_;
+  }
+
+  inline bool finished() const {
+    return resume_ < 0;
+  }
+
+  // runtime accounting
+  inline uint32_t runs() const {
+    return runs_;
+  }
+
+  inline unsigned long busyUs() const {
+    return busyUs_;
+  }
+
+  inline unsigned long maxUs() const {
+    return maxUs_;
+  }
+
+  inline void resetStats() {
+    runs_ = 0;
+    busyUs_ = maxUs_ = 0;
+  }
+
+  // the deadline a is reached, safe across the wrap around
+  static inline bool reached(unsigned long now, unsigned long a) {
+    return static_cast<long>(now - a) >= 0;
+  }
+
+protected:
+  virtual void run() = 0;
+
+  inline bool timedOut() const {
+    return timedOut_;
+  }
+
+protected:
+  static constexpr unsigned long TASK_POLL = 10;  // ms
+
+  int resume_{};  // line to resume, 0 to start, -1 for finished
+  unsigned long now_{};
+  unsigned long wakeAt_{};
+  unsigned long timeout_{};
+  bool timedOut_{};
+
+private:
+  friend class TaskRunner;
+
+  const char *name_;
+  Task *next_{};
+
+  uint32_t runs_{};
+  unsigned long busyUs_{};
+  unsigned long maxUs_{};
+};
+
+class TaskRunner {
+public:
+  using Clock = unsigned long (*)();
+
+  TaskRunner(Clock ms, Clock us)
+    : ms_(ms), us_(us) {}
+
+  void add(Task &task);
+
+  // run all the tasks due, once
+  void tick();
+
+  // the earlier one of next and the next wake up of all the tasks
+  unsigned long nextDeadline(unsigned long next) const;
+
+  template <typename F>
+  void forEach(F &&f) {
+    for (Task *t = head_; t != nullptr; t = t->next_) {
+      f(*t);
+    }
+  }
+
+private:
+  Clock ms_;
+  Clock us_;
+  Task *head_{};
+};
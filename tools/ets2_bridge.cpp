@@ -0,0 +1,382 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Poll the ETS2 telemetry server on the gaming PC, and push the changes to the
+// dashboard over UDP (see src/game/ets2_udp.hpp).
+//
+// Usage: ets2_bridge [options] <dashboard IP>[:port]
+//        ets2_bridge -l [port]   print the received packets, for testing
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../config.h"
+#include "../src/game/ets2_scanner.hpp"
+#include "../src/game/ets2_udp.hpp"
+
+using Clock = std::chrono::steady_clock;
+using Ms = std::chrono::milliseconds;
+
+static constexpr int HTTP_TIMEOUT = 500;  // ms
+
+// EV_TRUCKS in config.h, add more with -e
+static std::vector<std::string> evTrucks(std::begin(EV_TRUCKS), std::end(EV_TRUCKS) - 1);  // without nullptr
+
+struct Options {
+  std::string host{ "127.0.0.1" };
+  std::string port{ "25555" };
+  std::string path{ "/api/ets2/telemetry" };
+  int interval{ 100 };   // polling interval (ms)
+  int keyframe{ 1000 };  // keyframe interval (ms)
+  int heartbeat{ 250 };  // max silence when nothing changed (ms)
+  double tankSize{ DEFAULT_TANK_SIZE };
+  bool verbose{};
+};
+
+static volatile sig_atomic_t running = 1;
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options] <dashboard IP>[:port]\n"
+          "       %s -l [port]\n"
+          "  -a URL   telemetry API (http://127.0.0.1:25555/api/ets2/telemetry)\n"
+          "  -i MS    polling interval (100)\n"
+          "  -k MS    keyframe interval (1000)\n"
+          "  -b MS    heartbeat interval (250)\n"
+          "  -t L     fallback fuel capacity (1200)\n"
+          "  -e NAME  electric truck model, could be repeated\n"
+          "  -v       print every packet sent\n"
+          "  -l       listen and print the packets like the dashboard\n",
+          prog, prog);
+  exit(1);
+}
+
+// only plain "http://host[:port][/path]" is supported
+static bool parseUrl(const char *url, Options &opt) {
+  static constexpr const char *SCHEME = "http://";
+  if (strncmp(url, SCHEME, strlen(SCHEME)) == 0) {
+    url += strlen(SCHEME);
+  }
+
+  const char *path = strchr(url, '/');
+  std::string hostPort = path ? std::string(url, path - url) : std::string(url);
+  opt.path = path ? path : "/";
+
+  size_t colon = hostPort.find(':');
+  opt.host = hostPort.substr(0, colon);
+  opt.port = (colon != std::string::npos) ? hostPort.substr(colon + 1) : "80";
+  return !opt.host.empty();
+}
+
+static int connectTo(const std::string &host, const std::string &port, int type) {
+  addrinfo hints{}, *res;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = type;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) {
+    return -1;
+  }
+
+  int fd = socket(res->ai_family, res->ai_socktype, 0);
+  if (fd >= 0) {
+    timeval tv{ 0, HTTP_TIMEOUT * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    if (connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(res);
+  return fd;
+}
+
+// simple blocking GET, the server is on the same PC, returns the body
+static bool httpGet(const Options &opt, std::string &body) {
+  int fd = connectTo(opt.host, opt.port, SOCK_STREAM);
+  if (fd < 0) {
+    return false;
+  }
+
+  std::string req = "GET " + opt.path + " HTTP/1.1\r\nHost: " + opt.host + "\r\nConnection: close\r\n\r\n";
+  std::string resp;
+  if (send(fd, req.data(), req.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(req.size())) {
+    char buf[4096];
+    ssize_t n;
+    while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+      resp.append(buf, n);
+    }
+  }
+  close(fd);
+
+  size_t end = resp.find("\r\n\r\n");
+  if (end == std::string::npos || resp.compare(0, 9, "HTTP/1.1 ") != 0 || atoi(resp.c_str() + 9) != 200) {
+    return false;
+  }
+  body = resp.substr(end + 4);
+
+  if (strcasestr(resp.substr(0, end).c_str(), "Transfer-Encoding: chunked") != nullptr) {
+    std::string data;
+    size_t pos = 0;
+    while (pos < body.size()) {
+      size_t len = strtoul(body.c_str() + pos, nullptr, 16);
+      size_t start = body.find("\r\n", pos);
+      if (len == 0 || start == std::string::npos) {
+        break;
+      }
+      data.append(body, start + 2, len);
+      pos = start + 2 + len + 2;
+    }
+    body = data;
+  }
+  return true;
+}
+
+static bool isEV(const char *model) {
+  for (auto &m : evTrucks) {
+    if (m == model) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int16_t clamp16(double v) {
+  return static_cast<int16_t>(std::max(-32768.0, std::min(32767.0, std::round(v))));
+}
+
+// the same conversion as Ets2Game, in km
+static void toPushState(const Options &opt, const Ets2Telemetry &ets, Ets2PushState &push) {
+  int16_t *v = push.values;
+  if (!ets.hasGame || !ets.connected) {
+    v[PUSH_STATE] = PUSH_NOT_RUNNING;
+    return;  // keep the rest as is
+  }
+  v[PUSH_STATE] = ets.paused ? PUSH_PAUSED : PUSH_RUNNING;
+
+  if (ets.hasTruck) {
+    uint16_t lights = 0;
+    auto set = [&lights](bool on, uint16_t bit) {
+      lights |= on ? bit : 0;
+    };
+    set(ets.electricOn, LIGHT_ELECTRIC);
+    set(isEV(ets.model), LIGHT_EV);
+    set(ets.lowBeam, LIGHT_LOW_BEAM);
+    set(ets.parkingLight, LIGHT_PARKING);
+    set(ets.highBeam, LIGHT_HIGH_BEAM);
+    set(ets.leftBlinker, LIGHT_LBLINKER);
+    set(ets.rightBlinker, LIGHT_RBLINKER);
+    set(ets.beacon, LIGHT_BEACON);
+    set(ets.brake, LIGHT_BRAKE);
+    set(ets.parkBrake, LIGHT_PARK_BRAKE);
+    set(ets.airWarn, LIGHT_AIR_WARN);
+    set(ets.airEmerg, LIGHT_AIR_EMERG);
+    set(ets.fuelWarn, LIGHT_FUEL_WARN);
+    v[PUSH_LIGHTS] = static_cast<int16_t>(lights);
+
+    v[PUSH_SPEED] = clamp16(std::fabs(ets.speed));
+    v[PUSH_CRUISE] = ets.cruiseOn ? clamp16(ets.cruiseSpeed) : 0;
+
+    double tank = (ets.fuelCapacity > 0) ? ets.fuelCapacity : opt.tankSize;
+    v[PUSH_FUEL] = clamp16(ets.fuel * 100 / tank);
+    if (ets.fuelAvg > 0) {
+      v[PUSH_FUEL_DIST] = clamp16(ets.fuel / ets.fuelAvg);
+    }  // else keep the previous value
+  }
+
+  if (ets.hasNav) {
+    v[PUSH_ETA_DIST] = clamp16(ets.etaDist / 1000);
+    v[PUSH_ETA_TIME] = clamp16(std::max(ets.etaTime, 0));
+    v[PUSH_LIMIT] = clamp16(ets.speedLimit);
+  }
+}
+
+static bool fetchTelemetry(const Options &opt, Ets2PushState &push) {
+  std::string json;
+  if (!httpGet(opt, json)) {
+    return false;
+  }
+
+  Ets2Telemetry ets{};
+  Ets2Scanner scanner;
+  scanner.begin(&ets);
+  if (scanner.feed(json.data(), json.size()) != Ets2Scanner::Status::DONE) {
+    return false;
+  }
+  toPushState(opt, ets, push);
+  return true;
+}
+
+static void printState(const Ets2PushHeader &hdr, size_t len, const Ets2PushState &s) {
+  const int16_t *v = s.values;
+  printf("#%-5u %s %2zuB fields=%04x state=%d lights=%04x speed=%d cruise=%d limit=%d fuel=%d%%/%dkm eta=%dkm/%dmin\n",
+         hdr.seq, (hdr.flags & PUSH_KEYFRAME) ? "K" : "D", len, hdr.fields, v[PUSH_STATE],
+         static_cast<uint16_t>(v[PUSH_LIGHTS]), v[PUSH_SPEED], v[PUSH_CRUISE], v[PUSH_LIMIT], v[PUSH_FUEL],
+         v[PUSH_FUEL_DIST], v[PUSH_ETA_DIST], v[PUSH_ETA_TIME]);
+  fflush(stdout);
+}
+
+static int bridge(const Options &opt, const std::string &dash) {
+  size_t colon = dash.find(':');
+  std::string port = (colon != std::string::npos) ? dash.substr(colon + 1) : std::to_string(ETS2_PUSH_PORT);
+  int fd = connectTo(dash.substr(0, colon), port, SOCK_DGRAM);
+  if (fd < 0) {
+    fprintf(stderr, "Invalid dashboard address: %s\n", dash.c_str());
+    return 1;
+  }
+  printf("Bridging http://%s:%s%s to %s:%s\n", opt.host.c_str(), opt.port.c_str(), opt.path.c_str(),
+         dash.substr(0, colon).c_str(), port.c_str());
+
+  Ets2PushState curr{}, sent{};
+  uint16_t seq = 0;
+  uint64_t packets = 0, bytes = 0, failures = 0;
+  auto lastKey = Clock::time_point{}, lastSent = Clock::time_point{};
+  auto next = Clock::now();
+  bool online = true;
+
+  while (running) {
+    auto now = Clock::now();
+    if (!fetchTelemetry(opt, curr)) {
+      curr.values[PUSH_STATE] = PUSH_NOT_RUNNING;
+      failures++;
+      if (online) {
+        fprintf(stderr, "Telemetry server not available.\n");
+      }
+      online = false;
+    } else {
+      online = true;
+    }
+
+    bool key = (now - lastKey) >= Ms(opt.keyframe);
+    bool changed = memcmp(&curr, &sent, sizeof(curr)) != 0;
+    if (key || changed || (now - lastSent) >= Ms(opt.heartbeat)) {
+      uint8_t pkt[ETS2_PUSH_MAX_SIZE];
+      size_t len = Ets2PushEncode(pkt, ++seq, curr, key ? nullptr : &sent);
+      if (send(fd, pkt, len, 0) == static_cast<ssize_t>(len)) {
+        packets++;
+        bytes += len;
+      }
+      if (opt.verbose) {
+        Ets2PushHeader hdr;
+        memcpy(&hdr, pkt, sizeof(hdr));
+        printState(hdr, len, curr);
+      }
+      sent = curr;
+      lastSent = now;
+      if (key) {
+        lastKey = now;
+      }
+    }
+
+    next += Ms(opt.interval);
+    if (next < Clock::now()) {
+      next = Clock::now();  // too slow, don't catch up
+    }
+    std::this_thread::sleep_until(next);
+  }
+
+  printf("\n%lu packets, %lu bytes (%.1f bytes/packet), %lu fetch failures\n", packets, bytes,
+         packets ? double(bytes) / packets : 0.0, failures);
+  close(fd);
+  return 0;
+}
+
+// receive like Ets2PushGame, to check the bridge without the dashboard
+static int monitor(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (fd < 0 || bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+    perror("bind");
+    return 1;
+  }
+  timeval tv{ 0, 200 * 1000 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  printf("Listening on: %u\n", port);
+
+  Ets2PushState state{};
+  uint16_t seq = 0;
+  bool synced = false;
+  uint64_t lost = 0;
+  while (running) {
+    uint8_t pkt[256];
+    ssize_t n = recv(fd, pkt, sizeof(pkt), 0);
+    if (n <= 0) {
+      continue;
+    }
+
+    Ets2PushHeader hdr;
+    if (!Ets2PushDecode(pkt, n, state, hdr)) {
+      printf("Invalid packet of size %zd\n", n);
+      continue;
+    }
+    uint16_t gap = hdr.seq - seq - 1;
+    seq = hdr.seq;
+    if (hdr.flags & PUSH_KEYFRAME) {
+      synced = true;
+    } else if (gap != 0 && synced) {
+      lost += gap;
+      synced = false;
+    }
+    if (synced) {
+      printState(hdr, n, state);
+    }
+  }
+
+  printf("\n%lu packets lost\n", lost);
+  close(fd);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  Options opt;
+  bool listening = false;
+
+  int c;
+  while ((c = getopt(argc, argv, "a:i:k:b:t:e:vl")) != -1) {
+    switch (c) {
+      case 'a':
+        if (!parseUrl(optarg, opt)) {
+          usage(argv[0]);
+        }
+        break;
+      case 'i': opt.interval = std::max(atoi(optarg), 10); break;
+      case 'k': opt.keyframe = atoi(optarg); break;
+      case 'b': opt.heartbeat = atoi(optarg); break;
+      case 't': opt.tankSize = atof(optarg); break;
+      case 'e': evTrucks.emplace_back(optarg); break;
+      case 'v': opt.verbose = true; break;
+      case 'l': listening = true; break;
+      default: usage(argv[0]);
+    }
+  }
+
+  signal(SIGINT, [](int) {
+    running = 0;
+  });
+
+  if (listening) {
+    return monitor((optind < argc) ? atoi(argv[optind]) : ETS2_PUSH_PORT);
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+  }
+  return bridge(opt, argv[optind]);
+}
@@ -0,0 +1,129 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Host benchmark: Ets2Scanner vs. the ArduinoJson filter path it replaced.
+//
+// Usage: ets2_scan_bench [telemetry.json] [rounds]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../src/game/ets2_scanner.hpp"
+
+#if __has_include(<ArduinoJson.h>)
+#include <ArduinoJson.h>
+#define HAVE_ARDUINOJSON 1
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr size_t CHUNK_SIZE = 128;  // bytes per socket read on target
+
+template <typename F>
+static double benchmark(const char *name, int rounds, F &&parse) {
+  auto start = Clock::now();
+  for (int i = 0; i < rounds; i++) {
+    parse();
+  }
+  double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+  printf("%-12s %8.2f us/parse\n", name, us);
+  return us;
+}
+
+static bool scan(const std::string &json, Ets2Telemetry *ets) {
+  Ets2Scanner scanner;
+  scanner.begin(ets);
+  for (size_t i = 0; i < json.size() && scanner.status() == Ets2Scanner::Status::SCANNING; i += CHUNK_SIZE) {
+    scanner.feed(json.data() + i, std::min(CHUNK_SIZE, json.size() - i));
+  }
+  return scanner.status() == Ets2Scanner::Status::DONE;
+}
+
+#ifdef HAVE_ARDUINOJSON
+// same as the ArduinoJson filter once used by the firmware
+static DeserializationOption::Filter &ets2TelemetryFilter() {
+  static StaticJsonDocument<512> f;
+  static auto filter = DeserializationOption::Filter(f);
+
+  if (f.isNull()) {
+    auto g = f.createNestedObject("game");
+    g["connected"] = true;
+    g["paused"] = true;
+
+    auto t = f.createNestedObject("truck");
+    for (auto key : { "airPressureEmergencyOn", "airPressureWarningOn", "blinkerLeftActive", "blinkerRightActive",
+                      "cruiseControlOn", "cruiseControlSpeed", "electricOn", "fuel", "fuelAverageConsumption",
+                      "fuelCapacity", "fuelWarningOn", "lightsBeaconOn", "lightsBeamHighOn", "lightsBeamLowOn",
+                      "lightsBrakeOn", "lightsParkingOn", "model", "parkBrakeOn", "speed" }) {
+      t[key] = true;
+    }
+
+    auto n = f.createNestedObject("navigation");
+    n["estimatedDistance"] = true;
+    n["estimatedTime"] = true;
+    n["speedLimit"] = true;
+  }
+  return filter;
+}
+
+static bool arduinoJson(const std::string &json, double *speed) {
+  StaticJsonDocument<1024> ets;
+  if (deserializeJson(ets, json.data(), json.size(), ets2TelemetryFilter())) {
+    return false;
+  }
+  *speed = ets["truck"]["speed"];
+  return true;
+}
+#endif
+
+int main(int argc, char *argv[]) {
+  const char *path = (argc > 1) ? argv[1] : "ets2_telemetry.json";
+  int rounds = (argc > 2) ? atoi(argv[2]) : 10000;
+
+  std::ifstream file(path);
+  if (!file) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return 1;
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  std::string json = ss.str();
+
+  Ets2Telemetry ets{};
+  if (!scan(json, &ets)) {
+    fprintf(stderr, "Ets2Scanner failed on %s\n", path);
+    return 1;
+  }
+  printf("%zu bytes JSON, %d rounds\n", json.size(), rounds);
+  printf("scanned: model=\"%s\" speed=%.2f fuel=%.2f/%.2f eta=%.0fm/%dmin limit=%.0f\n",
+         ets.model, ets.speed, ets.fuel, ets.fuelCapacity, ets.etaDist, ets.etaTime, ets.speedLimit);
+
+  double scanUs = benchmark("Ets2Scanner", rounds, [&] {
+    scan(json, &ets);
+  });
+  printf("%-12s %8zu bytes state\n", "", sizeof(Ets2Scanner) + sizeof(Ets2Telemetry));
+
+#ifdef HAVE_ARDUINOJSON
+  double speed = 0;
+  if (!arduinoJson(json, &speed) || speed != ets.speed) {
+    fprintf(stderr, "ArduinoJson result mismatch\n");
+    return 1;
+  }
+  double jsonUs = benchmark("ArduinoJson", rounds, [&] {
+    arduinoJson(json, &speed);
+  });
+  printf("%-12s %8zu bytes state\n", "", sizeof(StaticJsonDocument<1024>) + sizeof(StaticJsonDocument<512>));
+  printf("speedup: %.2fx\n", jsonUs / scanUs);
+#else
+  (void)scanUs;
+  printf("ArduinoJson not found, set ARDUINOJSON=<path to ArduinoJson/src> to compare.\n");
+#endif
+  return 0;
+}
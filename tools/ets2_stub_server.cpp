@@ -0,0 +1,100 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Stub of the ETS2 telemetry server, serves the sample JSON with the speed and
+// blinkers animated, to run the bridge or the dashboard without the game.
+//
+// Usage: ets2_stub_server [telemetry.json] [port]
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+// replace the value of the first "key" in json
+static void setValue(std::string &json, const char *key, const std::string &value) {
+  std::string name = std::string("\"") + key + "\":";
+  size_t pos = json.find(name);
+  if (pos == std::string::npos) {
+    return;
+  }
+  pos = json.find_first_not_of(' ', pos + name.size());
+  size_t end = json.find_first_of(",\r\n}", pos);
+  json.replace(pos, end - pos, value);
+}
+
+static std::string animate(std::string json, double sec) {
+  char speed[16];
+  snprintf(speed, sizeof(speed), "%.5f", 45 + 40 * sin(sec / 10));
+  setValue(json, "speed", speed);
+
+  bool blink = fmod(sec, 1.0) < 0.5;
+  setValue(json, "blinkerLeftActive", blink ? "true" : "false");
+  return json;
+}
+
+int main(int argc, char *argv[]) {
+  const char *path = (argc > 1) ? argv[1] : "ets2_telemetry.json";
+  int port = (argc > 2) ? atoi(argv[2]) : 25555;
+
+  std::ifstream file(path);
+  if (!file) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return 1;
+  }
+  std::stringstream ss;
+  ss << file.rdbuf();
+  std::string json = ss.str();
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fd, 4) != 0) {
+    perror("bind");
+    return 1;
+  }
+  printf("Serving %s on: %d\n", path, port);
+
+  auto start = Clock::now();
+  for (;;) {
+    int conn = accept(fd, nullptr, nullptr);
+    if (conn < 0) {
+      continue;
+    }
+
+    // one request per connection, just wait for the end of headers
+    std::string req;
+    char buf[1024];
+    ssize_t n;
+    while (req.find("\r\n\r\n") == std::string::npos && (n = recv(conn, buf, sizeof(buf), 0)) > 0) {
+      req.append(buf, n);
+    }
+
+    double sec = std::chrono::duration<double>(Clock::now() - start).count();
+    std::string body = animate(json, sec);
+    std::string resp = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: application/json; charset=utf-8\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n"
+                       "\r\n" + body;
+    send(conn, resp.data(), resp.size(), MSG_NOSIGNAL);
+    close(conn);
+  }
+}
@@ -0,0 +1,41 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Host shim of the Arduino core, to run the display code in the tools. The
+// time is simulated: it only moves on delay(), so the output is repeatable.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include "Print.h"
+
+using std::max;
+using std::min;
+
+template <typename T, typename L, typename H>
+inline T constrain(T x, L low, H high) {
+  return (x < low) ? low : (x > high) ? high : x;
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// to stdout
+class HostSerial : public Print {
+public:
+  size_t write(uint8_t val) override;
+  using Print::write;
+};
+
+extern HostSerial Serial;
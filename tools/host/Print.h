@@ -0,0 +1,25 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Host shim of the Arduino Print class, only what the sketch uses.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t val) = 0;
+  virtual size_t write(const uint8_t *data, size_t len);
+
+  size_t print(const char *str);
+  size_t print(int num);
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
@@ -0,0 +1,25 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Host shim of the TimeLib functions used by the dashboards.
+
+#pragma once
+
+#include <ctime>
+
+int year(time_t t);
+int month(time_t t);  // 1~12
+int day(time_t t);
+int weekday(time_t t);  // 1 for Sunday
+int hour(time_t t);
+int hourFormat12(time_t t);
+bool isPM(time_t t);
+int minute(time_t t);
+int second(time_t t);
+
+char *dayShortStr(int day);
+char *monthShortStr(int month);
@@ -0,0 +1,116 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+
+#include <Arduino.h>
+#include <TimeLib.h>
+#include <cstdarg>
+
+HostSerial Serial;
+
+static uint64_t nowUs = 0;
+
+unsigned long millis() {
+  return nowUs / 1000;
+}
+
+unsigned long micros() {
+  return nowUs;
+}
+
+void delay(unsigned long ms) {
+  nowUs += ms * 1000ULL;
+}
+
+void delayMicroseconds(unsigned int us) {
+  nowUs += us;
+}
+
+size_t HostSerial::write(uint8_t val) {
+  return fputc(val, stdout) == EOF ? 0 : 1;
+}
+
+size_t Print::write(const uint8_t *data, size_t len) {
+  size_t n = 0;
+  while (len-- > 0) {
+    n += write(*data++);
+  }
+  return n;
+}
+
+size_t Print::print(const char *str) {
+  return write(reinterpret_cast<const uint8_t *>(str), strlen(str));
+}
+
+size_t Print::print(int num) {
+  return printf("%d", num);
+}
+
+size_t Print::printf(const char *fmt, ...) {
+  char buf[128];
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (len < 0) {
+    return 0;
+  }
+  return write(reinterpret_cast<const uint8_t *>(buf), min(static_cast<size_t>(len), sizeof(buf) - 1));
+}
+
+static struct tm breakTime(time_t t) {
+  struct tm tm;
+  gmtime_r(&t, &tm);
+  return tm;
+}
+
+int year(time_t t) {
+  return breakTime(t).tm_year + 1900;
+}
+
+int month(time_t t) {
+  return breakTime(t).tm_mon + 1;
+}
+
+int day(time_t t) {
+  return breakTime(t).tm_mday;
+}
+
+int weekday(time_t t) {
+  return breakTime(t).tm_wday + 1;
+}
+
+int hour(time_t t) {
+  return breakTime(t).tm_hour;
+}
+
+int hourFormat12(time_t t) {
+  int h = hour(t) % 12;
+  return (h == 0) ? 12 : h;
+}
+
+bool isPM(time_t t) {
+  return hour(t) >= 12;
+}
+
+int minute(time_t t) {
+  return breakTime(t).tm_min;
+}
+
+int second(time_t t) {
+  return breakTime(t).tm_sec;
+}
+
+char *dayShortStr(int day) {
+  static char names[][4]{ "Err", "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+  return names[(day >= 1 && day <= 7) ? day : 0];
+}
+
+char *monthShortStr(int month) {
+  static char names[][4]{ "Err", "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+  return names[(month >= 1 && month <= 12) ? month : 0];
+}
@@ -0,0 +1,145 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Renders the dashboards on a VirtualLcd through the real Display, and prints
+// each frame with the I2C bytes it took. The time is simulated, so the output
+// is the same on every run: "make check" diffs it against lcd_frames.golden
+// to see what a layout or flush change moved and what it costs.
+//
+// Usage: lcd_frames [frames]   frames of each racing lap, default 3
+
+#include <cstdio>
+#include <cstdlib>
+#include "../src/dashboard/clock.hpp"
+#include "../src/dashboard/racing.hpp"
+#include "../src/dashboard/truck.hpp"
+#include "../src/display/virtual_lcd.hpp"
+#include "../src/sched/task.hpp"
+
+static VirtualLcd lcd(LCD_ADDR, RGB_LED_NUM);
+static Display disp(lcd, LCD_ADDR);
+static TaskRunner tasks(millis, micros);
+
+static ClockDashboard clockDash(disp);
+static TruckDashboard truckDash(disp);
+static RacingDashboard racingDash(disp);
+
+// the owners, as the games
+static int clockOwner, ets2Owner, forzaOwner;
+
+static constexpr time_t EPOCH = 1767361530;  // 2026-01-02 13:45:30
+
+static uint32_t total = 0;
+static uint32_t switches = 0;
+
+// run the bus until the frame is on the glass, then print it
+static void show(const char *name) {
+  uint32_t start = lcd.busBytes();
+  while (!disp.flushed()) {
+    tasks.tick();
+    delay(1);
+  }
+  disp.ledFlush();
+
+  if (disp.switches() != switches) {
+    switches = disp.switches();
+    printf("Mode switch: %d LCD bytes (%d on I2C)%s\n", disp.switchBytes(),
+           disp.switchBytes() * static_cast<int>(LcdI2c::I2C_PER_BYTE), disp.switchRestored() ? ", restored" : "");
+  }
+
+  uint32_t bytes = lcd.busBytes() - start;
+  total += bytes;
+  printf("== %s: %d LCD bytes, %u I2C bytes, %u fields deferred\n", name, disp.flushBytes(), static_cast<unsigned>(bytes),
+         static_cast<unsigned>(disp.deferredFields()));
+  fputs(lcd.frame().c_str(), stdout);
+}
+
+static void clockFrames(time_t time, int count) {
+  for (int i = 0; i < count; i++) {
+    clockDash.fresh(&clockOwner, time + i);
+    show("clock");
+    delay(1000);
+  }
+}
+
+static void truckFrames(TruckState state, int count) {
+  for (int i = 0; i < count; i++) {
+    truckDash.fresh(&ets2Owner, EPOCH + i / TruckDashboard::FPS, &state, false);
+    show("truck");
+    state.speed += 1;
+    state.etaDist -= 1;
+    delay(1000 / TruckDashboard::FPS);
+  }
+}
+
+static void racingFrames(RacingState state, int count) {
+  for (int i = 0; i < count; i++) {
+    racingDash.fresh(&forzaOwner, &state, false);
+    show("racing");
+    state.rpm = state.rpmIdle + (state.rpmMax - state.rpmIdle) * (i + 1) / count;
+    state.rpmPeak = state.rpm;
+    state.speed += 3;
+    state.currLap += 1000 / RacingDashboard::FPS;
+    if (i == 0) {
+      // lap done, the delta pops over the current lap time
+      state.lap++;
+      state.lastLap = state.bestLap - 412;
+      state.bestLap = state.lastLap;
+      state.currLap = 0;
+    }
+    delay(1000 / RacingDashboard::FPS);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int frames = (argc > 1) ? atoi(argv[1]) : 3;
+
+  disp.start();
+  tasks.add(disp.bus());
+  show("boot");
+
+  TruckState truck{};
+  truck.on = true;
+  truck.headlight = true;
+  truck.leftBlinker = true;
+  truck.fuel = 64;
+  truck.fuelDist = 830;
+  truck.cruise = 80;
+  truck.speed = 78;
+  truck.etaDist = 412;
+  truck.etaTime = 275;
+  truck.limit = 80;
+
+  RacingState racing{};
+  racing.speed = 120;
+  racing.gear = 3;
+  racing.rpmIdle = 900;
+  racing.rpm = 5200;
+  racing.rpmPeak = 5200;
+  racing.rpmMax = 8000;
+  racing.fuel = 45;
+  racing.isPro = true;
+  racing.lap = 2;
+  racing.pos = 5;
+  racing.bestLap = 83512;
+  racing.lastLap = 84107;
+  racing.currLap = 12345;
+
+  // a session: clock, drive, race, and back to the restored screens
+  clockFrames(EPOCH, 2);
+  truckFrames(truck, 3);
+  racingFrames(racing, frames);
+  truckFrames(truck, 1);
+
+  // a notice over the dashboard, without a redraw before and after
+  disp.overlay(Display::Layer::SYSTEM, 11, 3, "WiFi lost", 1000);
+  truckFrames(truck, 3);
+  clockFrames(EPOCH + 60, 1);
+
+  printf("== total: %u I2C bytes\n", static_cast<unsigned>(total));
+  return 0;
+}
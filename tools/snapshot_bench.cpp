@@ -0,0 +1,91 @@
+// ETS2 LCD Dashboard for ESP8266/ESP32C3
+//
+// Copyright (C) 2026 Ding Zhaojie <zhaojie_ding@msn.com>
+//
+// This work is licensed under the terms of the GNU GPL, version 2 or later.
+// See the COPYING file in the top-level directory.
+//
+// Host stress test of Snapshot: an ingest thread publishing states as fast as
+// it can, and render threads checking that every state read is consistent.
+//
+// Usage: snapshot_bench [seconds] [readers]
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../src/sched/snapshot.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// about the size of RacingState/TruckState, every field derived from seq
+struct State {
+  uint32_t seq;
+  int32_t fields[15];
+
+  bool consistent() const {
+    for (int i = 0; i < 15; i++) {
+      if (fields[i] != static_cast<int32_t>(seq * (i + 1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+int main(int argc, char *argv[]) {
+  double seconds = (argc > 1) ? atof(argv[1]) : 2;
+  int readers = (argc > 2) ? atoi(argv[2]) : 2;
+
+  Snapshot<State> snapshot;
+  std::atomic<bool> stop{};
+  std::atomic<uint64_t> reads{}, torn{}, stale{}, backwards{};
+
+  std::thread ingest([&] {
+    State s{};
+    while (!stop.load(std::memory_order_relaxed)) {
+      s.seq++;
+      for (int i = 0; i < 15; i++) {
+        s.fields[i] = static_cast<int32_t>(s.seq * (i + 1));
+      }
+      snapshot.publish(s);
+    }
+  });
+
+  std::vector<std::thread> renders;
+  for (int r = 0; r < readers; r++) {
+    renders.emplace_back([&] {
+      State s{};
+      uint32_t last = 0, version;
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (!snapshot.read(s, &version)) {
+          stale++;  // keeps the last state
+          continue;
+        }
+        reads++;
+        torn += (s.consistent() && s.seq == version) ? 0 : 1;  // the version of the state read
+        backwards += (s.seq < last) ? 1 : 0;
+        last = s.seq;
+      }
+    });
+  }
+
+  auto start = Clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  stop = true;
+  ingest.join();
+  for (auto &t : renders) {
+    t.join();
+  }
+  double sec = std::chrono::duration<double>(Clock::now() - start).count();
+
+  printf("published: %u (%.1f M/s)\n", snapshot.version(), snapshot.version() / sec / 1e6);
+  printf("reads: %llu, retries: %u, gave up: %llu\n",
+         static_cast<unsigned long long>(reads.load()), snapshot.retries(),
+         static_cast<unsigned long long>(stale.load()));
+  printf("torn: %llu, backwards: %llu\n",
+         static_cast<unsigned long long>(torn.load()), static_cast<unsigned long long>(backwards.load()));
+  return (torn == 0 && backwards == 0) ? 0 : 1;
+}